@@ -8,10 +8,10 @@
 #include "rendering/Renderer.hpp"
 #include "rendering/TextureManager.hpp"
 #include "world/Chunk.hpp"
+#include "world/World.hpp"
 
 Player player;
 Window window;
-Chunk* model;
 
 int main()
 {
@@ -21,6 +21,10 @@ int main()
 	ShaderManager::RegisterShader(ShaderObject::Register("shaders/default", ShaderType::DEFAULT));
 	ShaderManager::RegisterShader(ShaderObject::Register("shaders/chunk", ShaderType::CHUNK));
 	ShaderManager::RegisterShader(ShaderObject::Register("shaders/shadow", ShaderType::SHADOW));
+	ShaderManager::RegisterShader(ShaderObject::Register("shaders/chunkShadowVertex.glsl", "shaders/shadowFragment.glsl", ShaderType::CHUNK_SHADOW));
+	ShaderManager::RegisterShader(ShaderObject::Register("shaders/chunkDisplacementVertex.glsl", "shaders/chunkFragment.glsl", ShaderType::CHUNK_DISPLACEMENT));
+	ShaderManager::RegisterShader(ShaderObject::Register("shaders/chunkDisplacementShadowVertex.glsl", "shaders/shadowFragment.glsl", ShaderType::CHUNK_DISPLACEMENT_SHADOW));
+	ShaderManager::RegisterShader(ShaderObject::Register("shaders/voxelVertex.glsl", "shaders/chunkFragment.glsl", ShaderType::VOXEL));
 	TextureManager::RegisterTexture(Texture::Register("textures/test_image.png", "test_texture"));
 	TextureManager::RegisterTexture(Texture::Register("textures/terrain.png", "terrain_atlas"));
 	TextureManager::RegisterTexture(Texture::Register("models/Tisch_t.png", "Tisch_t"));
@@ -37,8 +41,7 @@ int main()
 
 	player.InitalizePlayer({ 0.0f, 0.0f, 0.0f });
 	
-	model = new Chunk();
-	model->InitalizeChunk({0, 0, 0});
+	World::InitalizeWorld();
 
 	Logger_WriteConsole("Hello, World!", LogLevel::INFO);
 
@@ -50,6 +53,7 @@ int main()
 		
 		Input::UpdateInput();
 		player.Update();
+		World::Update(player.data.transform.position, player.data.camera.data.transform.rotation);
 
 		LightingManager::PostLightingInstructions(player.data.camera);
 		Renderer::RenderObjects(player.data.camera);
@@ -60,8 +64,12 @@ int main()
 	}
 
 	window.CleanUp();
-	model->CleanUp();
+	World::CleanUp();
 	Renderer::CleanUpObjects();
+	IndexBufferManager::CleanUp();
+	ShaderManager::CleanUp();
+	ShadowManager::CleanUp();
+	TextureManager::CleanUp();
 
 	EventSystem::DispatchEvent(EventType::MR_CLEANUP_EVENT, NULL);
 
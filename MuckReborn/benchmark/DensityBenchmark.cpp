@@ -0,0 +1,270 @@
+// Standalone, no window or GL context required, only glm on the include path:
+// g++ -std=c++17 -O2 -pthread -IMuckReborn/include MuckReborn/benchmark/DensityBenchmark.cpp -o DensityBenchmark
+//
+// ./DensityBenchmark [--quick]
+//
+// Generates a block of density chunks the way DensityChunk::Generate does, the field off the coarse grid and surface nets,
+// and times them against level 0 heightmap chunks, noise alone and noise plus erosion the way Chunk::Generate does. Also
+// samples every field directly at full resolution to show what the coarse grid saves, and generates the block again
+// across a ThreadPool. Prints one JSON document. The exit code is non-zero when the welded meshes of the block aren't
+// closed and consistently wound away from its outer faces, a vertex isn't shared by the triangles around it, the parallel
+// run doesn't reproduce the serial one, or the block has no caves or overhangs at all.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "core/ThreadPool.hpp"
+#include "world/Erosion.hpp"
+#include "world/Heightfield.hpp"
+#include "world/SurfaceNets.hpp"
+
+// Mirrors world/Chunk.hpp and world/DensityChunk.hpp, which pull in the renderer.
+#define BENCHMARK_CHUNK_SIZE 6
+#define BENCHMARK_CHUNK_RESOLUTION 8
+#define BENCHMARK_EROSION_ITERATIONS 4096
+#define BENCHMARK_DENSITY_RESOLUTION 4
+#define BENCHMARK_DENSITY_COARSE_FACTOR 2
+#define BENCHMARK_DENSITY_AMPLITUDE 1.5f
+#define BENCHMARK_DENSITY_FALLOFF 0.5f
+
+struct DensityMesh
+{
+	glm::vec3 origin;
+	std::vector<SurfaceVertex> vertices;
+	std::vector<unsigned int> indices;
+};
+
+static int side = 3;
+
+static DensityField Prepare(int x, int y, int z, int factor)
+{
+	const glm::vec3 origin = glm::vec3{ static_cast<float>(x), static_cast<float>(y), static_cast<float>(z) } * static_cast<float>(BENCHMARK_CHUNK_SIZE);
+
+	return DensityField::Register(origin, 1.0f / BENCHMARK_DENSITY_RESOLUTION, BENCHMARK_CHUNK_SIZE * BENCHMARK_DENSITY_RESOLUTION, factor);
+}
+
+static DensityMesh Generate(const Noise& noise, int index, int factor, bool mesh = true)
+{
+	const int x = index % side, y = (index / side) % 2 - 1, z = index / (side * 2);
+	DensityField field = Prepare(x, y, z, factor);
+	DensityMesh out = { field.origin, {}, {} };
+
+	field.Generate(noise, BENCHMARK_CHUNK_SIZE * 4, BENCHMARK_DENSITY_AMPLITUDE, BENCHMARK_DENSITY_FALLOFF, 0.0f);
+
+	if (mesh)
+		SurfaceNets::Generate(field, out.vertices, out.indices);
+
+	return out;
+}
+
+// Welds the vertices of every mesh by position and checks each directed edge is used as often as its reverse, unless it
+// runs along the outside of the block where the neighbouring chunk wasn't generated. Not once each, surface nets pinches
+// two sheets together along an edge where a cell has ambiguous corners.
+static bool IsClosed(const std::vector<DensityMesh>& meshes, const glm::vec3& minimum, const glm::vec3& maximum, size_t& openEdges)
+{
+	using Key = std::tuple<long, long, long>;
+
+	std::map<Key, unsigned int> welded;
+	std::map<std::pair<unsigned int, unsigned int>, int> edges;
+	std::vector<glm::vec3> positions;
+
+	const float margin = 1.5f / BENCHMARK_DENSITY_RESOLUTION;
+
+	for (const DensityMesh& mesh : meshes)
+	{
+		std::vector<unsigned int> remap(mesh.vertices.size());
+
+		for (size_t i = 0; i < mesh.vertices.size(); i++)
+		{
+			const glm::vec3 position = mesh.origin + mesh.vertices[i].position;
+			const Key key = { std::lround(position.x * 1024.0f), std::lround(position.y * 1024.0f), std::lround(position.z * 1024.0f) };
+			const auto found = welded.try_emplace(key, static_cast<unsigned int>(positions.size()));
+
+			if (found.second)
+				positions.push_back(position);
+
+			remap[i] = found.first->second;
+		}
+
+		for (size_t i = 0; i < mesh.indices.size(); i += 3)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				edges[{ remap[mesh.indices[i + j]], remap[mesh.indices[i + (j + 1) % 3]] }]++;
+			}
+		}
+	}
+
+	auto OnOutside = [&](const glm::vec3& position)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (position[axis] < minimum[axis] + margin || position[axis] > maximum[axis] - margin)
+				return true;
+		}
+
+		return false;
+	};
+
+	openEdges = 0;
+
+	for (const auto& edge : edges)
+	{
+		const auto reverse = edges.find({ edge.first.second, edge.first.first });
+
+		if (reverse != edges.end() && reverse->second == edge.second)
+			continue;
+
+		openEdges++;
+
+		if (!OnOutside(positions[edge.first.first]) || !OnOutside(positions[edge.first.second]))
+			return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+
+		if (argument == "--quick")
+			side = 2;
+		else
+		{
+			std::fprintf(stderr, "unknown argument '%s'\n", argument.c_str());
+			return 2;
+		}
+	}
+
+	const Noise noise(0.45f, 10.0f);
+	const HydraulicErosion erosion = HydraulicErosion::Register(BENCHMARK_EROSION_ITERATIONS, noise.GetSeed());
+
+	// side by 2 by side chunks, one layer under y = 0 and one over it, so the surface runs through the middle.
+	const int count = side * 2 * side;
+
+	double heightNoiseMilliseconds = 0.0;
+	double heightErodedMilliseconds = 0.0;
+
+	for (int i = 0; i < side * side; i++)
+	{
+		const glm::vec2 origin = { static_cast<float>(i % side * BENCHMARK_CHUNK_SIZE), static_cast<float>(i / side * BENCHMARK_CHUNK_SIZE) };
+		Heightfield heightfield = Heightfield::Register(origin, 1.0f / BENCHMARK_CHUNK_RESOLUTION, BENCHMARK_CHUNK_SIZE * BENCHMARK_CHUNK_RESOLUTION + 1, 1 + erosion.GetHalo());
+
+		auto start = std::chrono::steady_clock::now();
+
+		heightfield.Generate(noise, BENCHMARK_CHUNK_SIZE * 4, 1.0f, 0.0f);
+
+		const double noiseMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		erosion.Erode(heightfield);
+
+		heightNoiseMilliseconds += noiseMilliseconds;
+		heightErodedMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	heightNoiseMilliseconds /= side * side;
+	heightErodedMilliseconds /= side * side;
+
+	std::vector<DensityMesh> meshes;
+	double fieldMilliseconds = 0.0;
+	double meshMilliseconds = 0.0;
+
+	for (int i = 0; i < count; i++)
+	{
+		const int x = i % side, y = (i / side) % 2 - 1, z = i / (side * 2);
+		DensityField field = Prepare(x, y, z, BENCHMARK_DENSITY_COARSE_FACTOR);
+		DensityMesh mesh = { field.origin, {}, {} };
+
+		auto start = std::chrono::steady_clock::now();
+
+		field.Generate(noise, BENCHMARK_CHUNK_SIZE * 4, BENCHMARK_DENSITY_AMPLITUDE, BENCHMARK_DENSITY_FALLOFF, 0.0f);
+
+		auto middle = std::chrono::steady_clock::now();
+
+		SurfaceNets::Generate(field, mesh.vertices, mesh.indices);
+
+		fieldMilliseconds += std::chrono::duration<double, std::milli>(middle - start).count();
+		meshMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - middle).count();
+		meshes.push_back(std::move(mesh));
+	}
+
+	fieldMilliseconds /= count;
+	meshMilliseconds /= count;
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < count; i++)
+		Generate(noise, i, 1, false);
+
+	const double fullMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / count;
+
+	ThreadPool pool;
+	std::vector<DensityMesh> parallel(count);
+
+	start = std::chrono::steady_clock::now();
+	pool.ParallelFor(count, [&](size_t index) { parallel[index] = Generate(noise, static_cast<int>(index), BENCHMARK_DENSITY_COARSE_FACTOR); });
+
+	const double parallelMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	bool deterministic = true;
+	size_t vertices = 0, triangles = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		deterministic = deterministic && parallel[i].indices == meshes[i].indices && parallel[i].vertices.size() == meshes[i].vertices.size();
+
+		for (size_t j = 0; deterministic && j < meshes[i].vertices.size(); j++)
+			deterministic = parallel[i].vertices[j].position == meshes[i].vertices[j].position;
+
+		vertices += meshes[i].vertices.size();
+		triangles += meshes[i].indices.size() / 3;
+	}
+
+	// Ground is only volumetric where some column crosses the surface more than once, probed down the block's columns.
+	size_t overhangs = 0;
+
+	for (int z = 0; z < side * BENCHMARK_CHUNK_SIZE * BENCHMARK_DENSITY_RESOLUTION; z += 3)
+	{
+		for (int x = 0; x < side * BENCHMARK_CHUNK_SIZE * BENCHMARK_DENSITY_RESOLUTION; x += 3)
+		{
+			int crossings = 0;
+			float previous = 1.0f;
+
+			for (int y = -BENCHMARK_CHUNK_SIZE * BENCHMARK_DENSITY_RESOLUTION; y <= BENCHMARK_CHUNK_SIZE * BENCHMARK_DENSITY_RESOLUTION; y++)
+			{
+				const glm::vec3 position = glm::vec3{ static_cast<float>(x), static_cast<float>(y), static_cast<float>(z) } / static_cast<float>(BENCHMARK_DENSITY_RESOLUTION);
+				const float density = noise.FractalNoise(2, position.x, position.y, position.z) * BENCHMARK_DENSITY_AMPLITUDE - position.y * BENCHMARK_DENSITY_FALLOFF;
+
+				crossings += (density > 0.0f) != (previous > 0.0f) ? 1 : 0;
+				previous = density;
+			}
+
+			overhangs += crossings > 1 ? 1 : 0;
+		}
+	}
+
+	size_t openEdges = 0;
+	const glm::vec3 maximum = glm::vec3{ static_cast<float>(side), 1.0f, static_cast<float>(side) } * static_cast<float>(BENCHMARK_CHUNK_SIZE);
+	const bool closed = IsClosed(meshes, { 0.0f, -static_cast<float>(BENCHMARK_CHUNK_SIZE), 0.0f }, maximum, openEdges);
+
+	// Three without any sharing, close to six on a closed surface. The copies of the neighbours' border cells each chunk
+	// keeps for its seams are only used by the triangles on its side.
+	const double sharing = vertices > 0 ? static_cast<double>(triangles) * 3.0 / vertices : 0.0;
+	const bool passed = closed && deterministic && sharing > 4.0 && overhangs > 0;
+
+	std::printf("{\n  \"chunks\": %d,\n  \"cellsPerSide\": %d,\n  \"coarseFactor\": %d,\n", count, BENCHMARK_CHUNK_SIZE * BENCHMARK_DENSITY_RESOLUTION, BENCHMARK_DENSITY_COARSE_FACTOR);
+	std::printf("  \"heightmapNoiseMs\": %.3f,\n  \"heightmapErodedMs\": %.3f,\n", heightNoiseMilliseconds, heightErodedMilliseconds);
+	std::printf("  \"densityFieldMs\": %.3f,\n  \"densityMeshMs\": %.3f,\n  \"densityTotalMs\": %.3f,\n  \"densityFieldFullResolutionMs\": %.3f,\n", fieldMilliseconds, meshMilliseconds, fieldMilliseconds + meshMilliseconds, fullMilliseconds);
+	std::printf("  \"parallelMsPerChunk\": %.3f,\n  \"threads\": %zu,\n", parallelMilliseconds / count, static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())));
+	std::printf("  \"vertices\": %zu,\n  \"triangles\": %zu,\n  \"indicesPerVertex\": %.2f,\n  \"overhangColumns\": %zu,\n  \"openEdges\": %zu,\n", vertices, triangles, sharing, overhangs, openEdges);
+	std::printf("  \"closed\": %s,\n  \"deterministic\": %s,\n  \"passed\": %s\n}\n", closed ? "true" : "false", deterministic ? "true" : "false", passed ? "true" : "false");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
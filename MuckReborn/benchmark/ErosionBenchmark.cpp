@@ -0,0 +1,195 @@
+// Standalone, no window or GL context required, only glm on the include path:
+// g++ -std=c++17 -O2 -ffp-contract=off -pthread -IMuckReborn/include MuckReborn/benchmark/ErosionBenchmark.cpp -o ErosionBenchmark
+//
+// ./ErosionBenchmark [--quick]
+//
+// Erodes a 3x3 block of chunk sized tiles at several droplet budgets, on pools of 1, 2 and N threads (at least 4),
+// and prints one JSON document with the milliseconds per tile. The exit code is non-zero when a shared tile edge
+// differs between neighbours, erosion never reaches a tile border, or a pooled result differs from eroding the
+// tiles one after another on the calling thread.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "world/Erosion.hpp"
+
+#define BENCHMARK_TILES 3
+#define BENCHMARK_TILE_RESOLUTION 49
+#define BENCHMARK_TILE_STEP 0.125f
+
+struct ErosionResult
+{
+	int iterations;
+	size_t threads;
+	double milliseconds;
+	bool seamless;
+	bool bordersEroded;
+	bool deterministic;
+};
+
+static double minimumSeconds = 1.0;
+
+static std::vector<Heightfield> GenerateTiles(const Noise& noise, int apron)
+{
+	std::vector<Heightfield> out;
+
+	for (int z = 0; z < BENCHMARK_TILES; z++)
+	{
+		for (int x = 0; x < BENCHMARK_TILES; x++)
+		{
+			const float size = (BENCHMARK_TILE_RESOLUTION - 1) * BENCHMARK_TILE_STEP;
+
+			out.push_back(Heightfield::Register({ x * size, z * size }, BENCHMARK_TILE_STEP, BENCHMARK_TILE_RESOLUTION, apron));
+			out.back().Generate(noise, 24, 1.0f, 0.0f);
+		}
+	}
+
+	return out;
+}
+
+static bool IsSeamless(const std::vector<Heightfield>& tiles)
+{
+	const int last = BENCHMARK_TILE_RESOLUTION - 1;
+
+	for (int z = 0; z < BENCHMARK_TILES; z++)
+	{
+		for (int x = 0; x < BENCHMARK_TILES; x++)
+		{
+			const Heightfield& tile = tiles[z * BENCHMARK_TILES + x];
+
+			for (int i = 0; i < BENCHMARK_TILE_RESOLUTION; i++)
+			{
+				if (x + 1 < BENCHMARK_TILES)
+				{
+					const Heightfield& right = tiles[z * BENCHMARK_TILES + x + 1];
+
+					if (tile.Get(last, i) != right.Get(0, i) || tile.GetNormal(last, i) != right.GetNormal(0, i))
+						return false;
+				}
+
+				if (z + 1 < BENCHMARK_TILES)
+				{
+					const Heightfield& below = tiles[(z + 1) * BENCHMARK_TILES + x];
+
+					if (tile.Get(i, last) != below.Get(i, 0) || tile.GetNormal(i, last) != below.GetNormal(i, 0))
+						return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+// Droplets cross tile edges like any other sample, so the borders have to move too, not just stay in agreement.
+static bool ErodesBorders(const std::vector<Heightfield>& tiles, const std::vector<Heightfield>& source)
+{
+	const int last = BENCHMARK_TILE_RESOLUTION - 1;
+
+	for (size_t t = 0; t < tiles.size(); t++)
+	{
+		for (int i = 0; i < BENCHMARK_TILE_RESOLUTION; i++)
+		{
+			if (tiles[t].Get(i, 0) != source[t].Get(i, 0) || tiles[t].Get(i, last) != source[t].Get(i, last) ||
+				tiles[t].Get(0, i) != source[t].Get(0, i) || tiles[t].Get(last, i) != source[t].Get(last, i))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+static ErosionResult Run(const Noise& noise, int iterations, ThreadPool& pool, const std::vector<Heightfield>& reference)
+{
+	const HydraulicErosion erosion = HydraulicErosion::Register(iterations, 0);
+	const std::vector<Heightfield> source = GenerateTiles(noise, 1 + erosion.GetHalo());
+
+	std::vector<Heightfield> tiles;
+	size_t runs = 0;
+	double seconds = 0.0;
+
+	while (seconds < minimumSeconds || runs == 0)
+	{
+		tiles = source;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		erosion.Erode(tiles, pool);
+		seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		runs++;
+	}
+
+	bool deterministic = reference.empty();
+
+	if (!deterministic)
+	{
+		deterministic = true;
+
+		for (size_t i = 0; i < tiles.size(); i++)
+			deterministic = deterministic && tiles[i].heights == reference[i].heights;
+	}
+
+	return { iterations, pool.GetThreadCount(), seconds * 1000.0 / (static_cast<double>(runs) * tiles.size()), IsSeamless(tiles), ErodesBorders(tiles, source), deterministic };
+}
+
+static std::vector<Heightfield> Reference(const Noise& noise, int iterations)
+{
+	const HydraulicErosion erosion = HydraulicErosion::Register(iterations, 0);
+	std::vector<Heightfield> tiles = GenerateTiles(noise, 1 + erosion.GetHalo());
+
+	for (Heightfield& tile : tiles)
+		erosion.Erode(tile);
+
+	return tiles;
+}
+
+int main(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+
+		if (argument == "--quick")
+			minimumSeconds = 0.05;
+		else
+		{
+			std::fprintf(stderr, "unknown argument '%s'\n", argument.c_str());
+			return 2;
+		}
+	}
+
+	const Noise noise(0.45f, 10.0f);
+	const int budgets[] = { 1024, 4096, 16384 };
+
+	ThreadPool single(1);
+	ThreadPool pair(2);
+	ThreadPool pool(std::max<size_t>(4, std::thread::hardware_concurrency()));
+
+	std::vector<ErosionResult> results;
+
+	for (int iterations : budgets)
+	{
+		const std::vector<Heightfield> reference = Reference(noise, iterations);
+
+		for (ThreadPool* threads : { &single, &pair, &pool })
+			results.push_back(Run(noise, iterations, *threads, reference));
+	}
+
+	bool passed = true;
+
+	std::printf("{\n  \"tileResolution\": %d,\n  \"benchmarks\": [\n", BENCHMARK_TILE_RESOLUTION);
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		passed = passed && results[i].seamless && results[i].bordersEroded && results[i].deterministic;
+
+		std::printf("    { \"iterations\": %d, \"threads\": %zu, \"msPerTile\": %.3f, \"seamless\": %s, \"bordersEroded\": %s, \"deterministic\": %s }%s\n", results[i].iterations, results[i].threads, results[i].milliseconds, results[i].seamless ? "true" : "false", results[i].bordersEroded ? "true" : "false", results[i].deterministic ? "true" : "false", i + 1 < results.size() ? "," : "");
+	}
+
+	std::printf("  ],\n  \"passed\": %s\n}\n", passed ? "true" : "false");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+// Standalone, no window or GL context required, any compiler flags:
+// g++ -std=c++17 -O2 -IMuckReborn/include MuckReborn/benchmark/FixedNoiseVectors.cpp -o FixedNoiseVectors
+//
+// ./FixedNoiseVectors [--write] [path]
+//
+// Checks FixedNoise against the test vectors in path (MuckReborn/benchmark/FixedNoiseVectors.txt by default) and prints one
+// JSON document, the exit code is non-zero on any mismatch. --write regenerates the file after an intentional change.
+//
+// Lines are "noise <frequency> <amplitude> <lacunarity> <persistence> <seed>", which selects the generator for the lines after it,
+// "simplex <x> <y> <value>" and "fractal <octaves> <x> <y> <value>", all coordinates and values in 16.16 fixed point.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "math/FixedNoise.hpp"
+
+struct VectorNoise
+{
+	float frequency;
+	float amplitude;
+	float lacunarity;
+	float persistence;
+	uint32_t seed;
+};
+
+static const VectorNoise vectorNoises[] =
+{
+	{ 0.45f, 10.0f, 2.0f, 0.5f, 0 },
+	{ 0.45f, 10.0f, 2.0f, 0.5f, 1337 },
+	{ 0.02f, 1.0f, 2.5f, 0.4f, 42 },
+};
+
+static bool WriteVectors(const std::string& path)
+{
+	std::ofstream file(path, std::ios::binary);
+
+	if (!file)
+		return false;
+
+	file << "# FixedNoise test vectors, see FixedNoiseVectors.cpp for the format. Regenerate with --write.\n";
+
+	for (const VectorNoise& parameters : vectorNoises)
+	{
+		const FixedNoise noise(Noise(parameters.frequency, parameters.amplitude, parameters.lacunarity, parameters.persistence, parameters.seed));
+		uint32_t state = 0x9E3779B9u ^ parameters.seed;
+
+		auto Next = [&]()
+		{
+			state = state * 1664525u + 1013904223u;
+
+			return static_cast<int32_t>(state >> 1) - (1 << 30);
+		};
+
+		file << "noise " << parameters.frequency << " " << parameters.amplitude << " " << parameters.lacunarity << " " << parameters.persistence << " " << parameters.seed << "\n";
+
+		// Lattice points, cell borders and the ends of the supported range first, then random coordinates within +-16384 units.
+		const int32_t edges[][2] = { { 0, 0 }, { FIXED_NOISE_ONE, 0 }, { 0, -FIXED_NOISE_ONE }, { -1, -1 }, { 1, 1 }, { INT32_MAX, INT32_MIN + 1 }, { INT32_MIN, INT32_MAX } };
+
+		for (const auto& edge : edges)
+			file << "simplex " << edge[0] << " " << edge[1] << " " << noise.SimplexNoise(edge[0], edge[1]) << "\n";
+
+		for (int i = 0; i < 64; i++)
+		{
+			const int32_t x = Next();
+			const int32_t y = Next();
+
+			file << "simplex " << x << " " << y << " " << noise.SimplexNoise(x, y) << "\n";
+		}
+
+		for (size_t octaves : { 1, 8, 24 })
+		{
+			for (int i = 0; i < 32; i++)
+			{
+				const int32_t x = Next() / 4;
+				const int32_t y = Next() / 4;
+
+				file << "fractal " << octaves << " " << x << " " << y << " " << noise.FractalNoise(octaves, x, y) << "\n";
+			}
+		}
+	}
+
+	return static_cast<bool>(file);
+}
+
+int main(int argc, char** argv)
+{
+	bool write = false;
+	std::string path = "MuckReborn/benchmark/FixedNoiseVectors.txt";
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--write") == 0)
+			write = true;
+		else
+			path = argv[i];
+	}
+
+	if (write)
+	{
+		if (!WriteVectors(path))
+		{
+			std::fprintf(stderr, "failed to write '%s'\n", path.c_str());
+			return 2;
+		}
+
+		return 0;
+	}
+
+	std::ifstream file(path);
+
+	if (!file)
+	{
+		std::fprintf(stderr, "failed to open '%s'\n", path.c_str());
+		return 2;
+	}
+
+	std::unique_ptr<FixedNoise> noise;
+	std::string line;
+	size_t lineNumber = 0;
+	size_t checked = 0;
+	size_t mismatches = 0;
+
+	std::printf("{\n  \"mismatches\": [\n");
+
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		std::istringstream stream(line);
+		std::string type;
+
+		stream >> type;
+
+		int64_t actual = 0;
+		int64_t expected = 0;
+
+		if (type == "noise")
+		{
+			VectorNoise parameters = {};
+
+			stream >> parameters.frequency >> parameters.amplitude >> parameters.lacunarity >> parameters.persistence >> parameters.seed;
+			noise = std::make_unique<FixedNoise>(Noise(parameters.frequency, parameters.amplitude, parameters.lacunarity, parameters.persistence, parameters.seed));
+
+			continue;
+		}
+		else if (type == "simplex" && noise)
+		{
+			int32_t x = 0, y = 0;
+
+			stream >> x >> y >> expected;
+			actual = noise->SimplexNoise(x, y);
+		}
+		else if (type == "fractal" && noise)
+		{
+			size_t octaves = 0;
+			int32_t x = 0, y = 0;
+
+			stream >> octaves >> x >> y >> expected;
+			actual = noise->FractalNoise(octaves, x, y);
+		}
+		else
+		{
+			std::fprintf(stderr, "line %zu: unknown vector '%s'\n", lineNumber, type.c_str());
+			return 2;
+		}
+
+		checked++;
+
+		if (actual != expected)
+		{
+			std::printf("%s    { \"line\": %zu, \"expected\": %lld, \"actual\": %lld }", mismatches ? ",\n" : "", lineNumber, static_cast<long long>(expected), static_cast<long long>(actual));
+			mismatches++;
+		}
+	}
+
+	std::printf("%s  ],\n  \"checked\": %zu,\n  \"passed\": %s\n}\n", mismatches ? "\n" : "", checked, mismatches == 0 ? "true" : "false");
+
+	return mismatches == 0 ? 0 : 1;
+}
\ No newline at end of file
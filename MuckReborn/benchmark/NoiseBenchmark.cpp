@@ -0,0 +1,497 @@
+// Standalone, no window or GL context required:
+// g++ -std=c++17 -O2 -ffp-contract=off -pthread -IMuckReborn/include MuckReborn/benchmark/NoiseBenchmark.cpp -o NoiseBenchmark
+//
+// Floating point contraction must stay off (the MSVC default), an FMA changes the rounding and every golden hash with it.
+//
+// ./NoiseBenchmark [--golden] [--quick] [--isa=scalar|sse2|avx2]
+//
+// Prints one JSON document to stdout. --golden skips the timings and only checks the golden hashes and the
+// quality tiers, the exit code is non-zero when a hash changed, a tier exceeded its bound or the bound exceeds
+// NOISE_SIMPLEX_2D_BOUND, or GenerateTiles at a tier differs from FillGrid2D at that tier.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "math/NoiseGraph.hpp"
+
+#define BENCHMARK_GOLDEN_SAMPLES 4096
+#define BENCHMARK_GRID_SIZE 64
+
+struct BenchmarkResult
+{
+	std::string name;
+	std::string path;
+	size_t octaves;
+	double nanoseconds;
+};
+
+struct GoldenResult
+{
+	std::string name;
+	uint64_t hash;
+	uint64_t expected;
+};
+
+struct TierResult
+{
+	std::string quality;
+	float step;
+	float maxError;
+	float bound;
+	bool tilesMatch;
+};
+
+struct GoldenValue
+{
+	const char* name;
+	uint64_t hash;
+};
+
+// Regenerate with --golden after an intentional change to the noise output and paste the printed hashes here.
+static const GoldenValue goldenValues[] =
+{
+	{ "simplex1d", 0x4c1e5ee41364aee9ull },
+	{ "simplex2d", 0x63291b15570c47bcull },
+	{ "simplex3d", 0x22e1c1c7c7951f9eull },
+	{ "fractal2d_1", 0x698a1c4eda454c5cull },
+	{ "fractal2d_8", 0x7e99d80c36d3c825ull },
+	{ "fractal2d_24", 0x2c15ed90d7199d90ull },
+	{ "fractal3d_8", 0x6ece36b5e46503ccull },
+	{ "fractal2d_deriv_8", 0x3c390ea3e2d9cc69ull },
+	{ "cellular2d", 0xa01648db1fdb722aull },
+	{ "seeded_fractal2d_8", 0x14807253961f3c7dull },
+	{ "fractal2d_8_batch", 0x7e99d80c36d3c825ull },
+	{ "fractal2d_8_grid", 0x88db241193d4007bull },
+	{ "fractal2d_8_tiles", 0x88db241193d4007bull },
+};
+
+static double minimumSeconds = 0.25;
+
+template<typename Function>
+double MeasureNanoseconds(size_t samples, Function function)
+{
+	size_t repeats = 0;
+	auto start = std::chrono::steady_clock::now();
+	auto end = start;
+
+	do
+	{
+		function();
+		repeats++;
+		end = std::chrono::steady_clock::now();
+	}
+	while (std::chrono::duration<double>(end - start).count() < minimumSeconds);
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(repeats * samples);
+}
+
+struct GoldenHasher
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	void Add(float value)
+	{
+		uint32_t bits;
+
+		std::memcpy(&bits, &value, sizeof(float));
+		Add(bits);
+	}
+
+	void Add(uint32_t bits)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			hash ^= (bits >> (i * 8)) & 0xFF;
+			hash *= 1099511628211ull;
+		}
+	}
+};
+
+struct Coordinates
+{
+	std::vector<float> xs, ys, zs;
+
+	static Coordinates Register(size_t count)
+	{
+		Coordinates out = {};
+		uint32_t state = 0x9E3779B9u;
+
+		auto Next = [&]()
+		{
+			state = state * 1664525u + 1013904223u;
+
+			return static_cast<float>(state >> 8) * (1.0f / 16777216.0f) * 2000.0f - 1000.0f;
+		};
+
+		for (size_t i = 0; i < count; i++)
+		{
+			out.xs.push_back(Next());
+			out.ys.push_back(Next());
+			out.zs.push_back(Next());
+		}
+
+		return out;
+	}
+};
+
+std::vector<GoldenResult> RunGolden(const Noise& noise, const Noise& seeded, const Coordinates& coordinates, ThreadPool& pool)
+{
+	std::vector<GoldenResult> out;
+	const size_t count = coordinates.xs.size();
+	const float* xs = coordinates.xs.data();
+	const float* ys = coordinates.ys.data();
+	const float* zs = coordinates.zs.data();
+
+	auto Record = [&](const std::string& name, const GoldenHasher& hasher)
+	{
+		GoldenResult result = { name, hasher.hash, 0 };
+
+		for (const GoldenValue& value : goldenValues)
+		{
+			if (name == value.name)
+				result.expected = value.hash;
+		}
+
+		out.push_back(result);
+	};
+
+	GoldenHasher simplex1d, simplex2d, simplex3d, fractal3d, fractalDeriv, cellular, seededFractal;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		simplex1d.Add(noise.SimplexNoise(xs[i]));
+		simplex2d.Add(noise.SimplexNoise(xs[i], zs[i]));
+		simplex3d.Add(noise.SimplexNoise(xs[i], ys[i], zs[i]));
+		fractal3d.Add(noise.FractalNoise(8, xs[i], ys[i], zs[i]));
+		seededFractal.Add(seeded.FractalNoise(8, xs[i], zs[i]));
+
+		const NoiseSample sample = noise.FractalNoiseDeriv(8, xs[i], zs[i]);
+
+		fractalDeriv.Add(sample.value);
+		fractalDeriv.Add(sample.dx);
+		fractalDeriv.Add(sample.dy);
+
+		const CellularSample cell = noise.CellularNoise(xs[i], zs[i], 0.1f);
+
+		cellular.Add(cell.f1);
+		cellular.Add(cell.f2);
+		cellular.Add(static_cast<uint32_t>(cell.id1));
+		cellular.Add(static_cast<uint32_t>(cell.id2));
+	}
+
+	Record("simplex1d", simplex1d);
+	Record("simplex2d", simplex2d);
+	Record("simplex3d", simplex3d);
+
+	for (size_t octaves : { 1, 8, 24 })
+	{
+		GoldenHasher hasher;
+
+		for (size_t i = 0; i < count; i++)
+			hasher.Add(noise.FractalNoise(octaves, xs[i], zs[i]));
+
+		Record("fractal2d_" + std::to_string(octaves), hasher);
+	}
+
+	Record("fractal3d_8", fractal3d);
+	Record("fractal2d_deriv_8", fractalDeriv);
+	Record("cellular2d", cellular);
+	Record("seeded_fractal2d_8", seededFractal);
+
+	std::vector<float> batch(count);
+	GoldenHasher batchHasher;
+
+	noise.FractalNoise2D(8, xs, zs, batch.data(), count);
+
+	for (float value : batch)
+		batchHasher.Add(value);
+
+	Record("fractal2d_8_batch", batchHasher);
+
+	std::vector<float> grid(BENCHMARK_GRID_SIZE * BENCHMARK_GRID_SIZE);
+	GoldenHasher gridHasher;
+
+	noise.FillGrid2D(-13.0f, 7.5f, 0.37f, BENCHMARK_GRID_SIZE, BENCHMARK_GRID_SIZE, 8, grid.data());
+
+	for (float value : grid)
+		gridHasher.Add(value);
+
+	Record("fractal2d_8_grid", gridHasher);
+
+	TileRequest request = {};
+	GoldenHasher tileHasher;
+
+	request.originX = -13.0f;
+	request.originZ = 7.5f;
+	request.step = 0.37f;
+	request.width = BENCHMARK_GRID_SIZE;
+	request.height = BENCHMARK_GRID_SIZE;
+	request.octaves = 8;
+	request.out = grid.data();
+
+	std::fill(grid.begin(), grid.end(), 0.0f);
+	noise.GenerateTiles(&request, 1, pool);
+
+	for (float value : grid)
+		tileHasher.Add(value);
+
+	Record("fractal2d_8_tiles", tileHasher);
+
+	return out;
+}
+
+// Each tier against FULL, and GenerateTiles at the tier against FillGrid2D at the tier, which have to match bit for bit.
+std::vector<TierResult> RunTiers(const Noise& noise, ThreadPool& pool)
+{
+	std::vector<TierResult> out;
+	std::vector<float> full(BENCHMARK_GRID_SIZE * BENCHMARK_GRID_SIZE);
+	std::vector<float> tier(full.size());
+	std::vector<float> tile(full.size());
+
+	for (float step : { 0.125f, 0.5f, 2.0f })
+	{
+		noise.FillGrid2D(-13.0f, 7.5f, step, BENCHMARK_GRID_SIZE, BENCHMARK_GRID_SIZE, 24, full.data());
+
+		for (NoiseQuality quality : { NoiseQuality::REDUCED, NoiseQuality::APPROXIMATE })
+		{
+			float maxError = 0.0f;
+
+			noise.FillGrid2D(-13.0f, 7.5f, step, BENCHMARK_GRID_SIZE, BENCHMARK_GRID_SIZE, 24, tier.data(), quality);
+
+			for (size_t i = 0; i < full.size(); i++)
+				maxError = std::max(maxError, std::fabs(tier[i] - full[i]));
+
+			TileRequest request = {};
+
+			request.originX = -13.0f;
+			request.originZ = 7.5f;
+			request.step = step;
+			request.width = BENCHMARK_GRID_SIZE;
+			request.height = BENCHMARK_GRID_SIZE;
+			request.octaves = 24;
+			request.quality = quality;
+			request.out = tile.data();
+
+			noise.GenerateTiles(&request, 1, pool);
+
+			out.push_back({ quality == NoiseQuality::REDUCED ? "reduced" : "approximate", step, maxError, noise.GetQualityError(quality, 24, step), tile == tier });
+		}
+	}
+
+	return out;
+}
+
+std::vector<BenchmarkResult> RunBenchmarks(const Noise& noise, const Coordinates& coordinates, ThreadPool& pool)
+{
+	std::vector<BenchmarkResult> out;
+	const size_t count = coordinates.xs.size();
+	const float* xs = coordinates.xs.data();
+	const float* ys = coordinates.ys.data();
+	const float* zs = coordinates.zs.data();
+	std::vector<float> output(count);
+	std::vector<float> grid(BENCHMARK_GRID_SIZE * BENCHMARK_GRID_SIZE);
+
+	out.push_back({ "simplex1d", "scalar", 0, MeasureNanoseconds(count, [&]()
+	{
+		for (size_t i = 0; i < count; i++)
+			output[i] = noise.SimplexNoise(xs[i]);
+	}) });
+
+	out.push_back({ "simplex2d", "scalar", 0, MeasureNanoseconds(count, [&]()
+	{
+		for (size_t i = 0; i < count; i++)
+			output[i] = noise.SimplexNoise(xs[i], zs[i]);
+	}) });
+
+	out.push_back({ "simplex3d", "scalar", 0, MeasureNanoseconds(count, [&]()
+	{
+		for (size_t i = 0; i < count; i++)
+			output[i] = noise.SimplexNoise(xs[i], ys[i], zs[i]);
+	}) });
+
+	for (size_t octaves : { 1, 8, 24 })
+	{
+		out.push_back({ "fractal1d", "scalar", octaves, MeasureNanoseconds(count, [&]()
+		{
+			for (size_t i = 0; i < count; i++)
+				output[i] = noise.FractalNoise(octaves, xs[i]);
+		}) });
+
+		out.push_back({ "fractal2d", "scalar", octaves, MeasureNanoseconds(count, [&]()
+		{
+			for (size_t i = 0; i < count; i++)
+				output[i] = noise.FractalNoise(octaves, xs[i], zs[i]);
+		}) });
+
+		out.push_back({ "fractal2d", "batch", octaves, MeasureNanoseconds(count, [&]()
+		{
+			noise.FractalNoise2D(octaves, xs, zs, output.data(), count);
+		}) });
+
+		out.push_back({ "fractal2d", "grid", octaves, MeasureNanoseconds(grid.size(), [&]()
+		{
+			noise.FillGrid2D(-13.0f, 7.5f, 0.125f, BENCHMARK_GRID_SIZE, BENCHMARK_GRID_SIZE, octaves, grid.data());
+		}) });
+
+		out.push_back({ "fractal2d", "grid_reduced", octaves, MeasureNanoseconds(grid.size(), [&]()
+		{
+			noise.FillGrid2D(-13.0f, 7.5f, 0.125f, BENCHMARK_GRID_SIZE, BENCHMARK_GRID_SIZE, octaves, grid.data(), NoiseQuality::REDUCED);
+		}) });
+
+		out.push_back({ "fractal2d", "grid_approximate", octaves, MeasureNanoseconds(grid.size(), [&]()
+		{
+			noise.FillGrid2D(-13.0f, 7.5f, 0.125f, BENCHMARK_GRID_SIZE, BENCHMARK_GRID_SIZE, octaves, grid.data(), NoiseQuality::APPROXIMATE);
+		}) });
+
+		out.push_back({ "fractal3d", "scalar", octaves, MeasureNanoseconds(count, [&]()
+		{
+			for (size_t i = 0; i < count; i++)
+				output[i] = noise.FractalNoise(octaves, xs[i], ys[i], zs[i]);
+		}) });
+
+		out.push_back({ "fractal3d", "batch", octaves, MeasureNanoseconds(count, [&]()
+		{
+			noise.FractalNoise3D(octaves, xs, ys, zs, output.data(), count);
+		}) });
+	}
+
+	const size_t tileCount = 16;
+	std::vector<float> tiles(tileCount * grid.size());
+	std::vector<TileRequest> requests(tileCount);
+
+	for (size_t i = 0; i < tileCount; i++)
+	{
+		requests[i].originX = static_cast<float>(i) * BENCHMARK_GRID_SIZE * 0.125f;
+		requests[i].originZ = 7.5f;
+		requests[i].step = 0.125f;
+		requests[i].width = BENCHMARK_GRID_SIZE;
+		requests[i].height = BENCHMARK_GRID_SIZE;
+		requests[i].octaves = 24;
+		requests[i].out = tiles.data() + i * grid.size();
+	}
+
+	out.push_back({ "fractal2d", "tiles_x" + std::to_string(pool.GetThreadCount()), 24, MeasureNanoseconds(tiles.size(), [&]()
+	{
+		noise.GenerateTiles(requests, pool);
+	}) });
+
+	NoiseGraph graph;
+	graph.SetOutput(graph.Add(graph.Multiply(graph.Fractal(24, 0.45f, 10.0f), graph.Constant(4.0f)), graph.Constant(1.0f)));
+
+	NoiseGraph warpedGraph;
+	std::string error;
+
+	NoiseGraph::Parse(
+		"base = fractal 24 0.45 10\n"
+		"ridges = ridged 6 0.1\n"
+		"warpX = fractal 4 0.05\n"
+		"warpZ = fractal 4 0.07\n"
+		"warped = warp ridges warpX warpZ 8\n"
+		"mask = curve base -0.2 0 0.2 1\n"
+		"height = select base warped mask 0.5 0.1\n", warpedGraph, error);
+
+	const NoiseProgram program = graph.Compile(noise);
+	const NoiseProgram warpedProgram = warpedGraph.Compile(noise);
+
+	out.push_back({ "graph_fractal2d", "grid", 24, MeasureNanoseconds(grid.size(), [&]()
+	{
+		program.FillGrid2D(-13.0f, 7.5f, 0.125f, BENCHMARK_GRID_SIZE, BENCHMARK_GRID_SIZE, grid.data());
+	}) });
+
+	out.push_back({ "graph_warped", "grid", 24, MeasureNanoseconds(grid.size(), [&]()
+	{
+		warpedProgram.FillGrid2D(-13.0f, 7.5f, 0.125f, BENCHMARK_GRID_SIZE, BENCHMARK_GRID_SIZE, grid.data());
+	}) });
+
+	std::vector<float> f2(count);
+	std::vector<int32_t> id1(count), id2(count);
+
+	out.push_back({ "cellular2d", "scalar", 0, MeasureNanoseconds(count, [&]()
+	{
+		for (size_t i = 0; i < count; i++)
+			output[i] = noise.CellularNoise(xs[i], zs[i], 0.1f).f1;
+	}) });
+
+	out.push_back({ "cellular2d", "batch", 0, MeasureNanoseconds(count, [&]()
+	{
+		noise.CellularNoise2D(0.1f, 1.0f, xs, zs, output.data(), f2.data(), id1.data(), id2.data(), count);
+	}) });
+
+	return out;
+}
+
+int main(int argc, char** argv)
+{
+	bool goldenOnly = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+
+		if (argument == "--golden")
+			goldenOnly = true;
+		else if (argument == "--quick")
+			minimumSeconds = 0.05;
+		else if (argument == "--isa=scalar")
+			NoiseSIMD::ActiveInstructionSet() = NoiseInstructionSet::SCALAR;
+		else if (argument == "--isa=sse2")
+			NoiseSIMD::ActiveInstructionSet() = std::min(NoiseInstructionSet::SSE2, NoiseSIMD::DetectInstructionSet());
+		else if (argument == "--isa=avx2")
+			NoiseSIMD::ActiveInstructionSet() = std::min(NoiseInstructionSet::AVX2, NoiseSIMD::DetectInstructionSet());
+		else
+		{
+			std::fprintf(stderr, "unknown argument '%s'\n", argument.c_str());
+			return 2;
+		}
+	}
+
+	const Noise noise(0.45f, 10.0f);
+	const Noise seeded(0.45f, 10.0f, 2.0f, 0.5f, 1337);
+	const Coordinates coordinates = Coordinates::Register(BENCHMARK_GOLDEN_SAMPLES);
+	ThreadPool pool;
+
+	const std::vector<GoldenResult> golden = RunGolden(noise, seeded, coordinates, pool);
+	const std::vector<TierResult> tiers = RunTiers(noise, pool);
+	std::vector<BenchmarkResult> benchmarks;
+
+	if (!goldenOnly)
+		benchmarks = RunBenchmarks(noise, coordinates, pool);
+
+	bool passed = true;
+
+	std::printf("{\n  \"instructionSet\": \"%s\",\n  \"golden\": [\n", NoiseSIMD::InstructionSet2String(NoiseSIMD::ActiveInstructionSet()));
+
+	for (size_t i = 0; i < golden.size(); i++)
+	{
+		const bool match = golden[i].hash == golden[i].expected;
+
+		passed = passed && match;
+
+		std::printf("    { \"name\": \"%s\", \"hash\": \"0x%016llx\", \"expected\": \"0x%016llx\", \"match\": %s }%s\n", golden[i].name.c_str(), static_cast<unsigned long long>(golden[i].hash), static_cast<unsigned long long>(golden[i].expected), match ? "true" : "false", i + 1 < golden.size() ? "," : "");
+	}
+
+	std::printf("  ],\n  \"tiers\": [\n");
+
+	for (size_t i = 0; i < tiers.size(); i++)
+	{
+		const bool within = tiers[i].maxError <= tiers[i].bound && tiers[i].bound <= NOISE_SIMPLEX_2D_BOUND;
+
+		passed = passed && within && tiers[i].tilesMatch;
+
+		std::printf("    { \"quality\": \"%s\", \"step\": %.3f, \"maxError\": %.6f, \"bound\": %.6f, \"within\": %s, \"tilesMatch\": %s }%s\n", tiers[i].quality.c_str(), tiers[i].step, tiers[i].maxError, tiers[i].bound, within ? "true" : "false", tiers[i].tilesMatch ? "true" : "false", i + 1 < tiers.size() ? "," : "");
+	}
+
+	std::printf("  ],\n  \"benchmarks\": [\n");
+
+	for (size_t i = 0; i < benchmarks.size(); i++)
+		std::printf("    { \"name\": \"%s\", \"path\": \"%s\", \"octaves\": %zu, \"nsPerSample\": %.3f }%s\n", benchmarks[i].name.c_str(), benchmarks[i].path.c_str(), benchmarks[i].octaves, benchmarks[i].nanoseconds, i + 1 < benchmarks.size() ? "," : "");
+
+	std::printf("  ],\n  \"passed\": %s\n}\n", passed ? "true" : "false");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
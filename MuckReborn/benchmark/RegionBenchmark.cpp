@@ -0,0 +1,264 @@
+// Standalone, no window or GL context required, only glm on the include path:
+// g++ -std=c++17 -O2 -IMuckReborn/include MuckReborn/benchmark/RegionBenchmark.cpp -o RegionBenchmark
+//
+// ./RegionBenchmark [--quick] [--path <file>]
+//
+// Generates a square of level 0 chunks the way Chunk::Generate does, noise and erosion, saves them to a region file,
+// reopens it and loads them back the way a revisit does: read from the mapping, decode, recalculate normals. Prints one
+// JSON document with the time per chunk for both and the bytes each chunk takes. Then edits one chunk with a few brush
+// strokes and saves only the differences, the way World does without CHUNK_CACHE_HEIGHTS. The exit code is non-zero when
+// a loaded height is off by more than half a quantum, a coarser level doesn't read back the level 0 samples under it, a
+// relocated write disturbs another chunk, rewriting a chunk keeps growing the file instead of reusing the sectors it
+// left, loading isn't faster than generating, or the base plus the loaded edits is off the edited chunk by more than
+// half a quantum.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "world/EditLayer.hpp"
+#include "world/Erosion.hpp"
+#include "world/Heightfield.hpp"
+#include "world/RegionFile.hpp"
+
+// Mirrors world/Chunk.hpp, which pulls in the renderer.
+#define BENCHMARK_CHUNK_SIZE 6
+#define BENCHMARK_CHUNK_RESOLUTION 8
+#define BENCHMARK_EROSION_ITERATIONS 4096
+#define BENCHMARK_HEIGHT_QUANTUM (1.0f / 1024.0f)
+#define BENCHMARK_EDIT_APRON 8
+
+static int side = 8;
+
+static Heightfield Prepare(const HydraulicErosion& erosion, int x, int z, int level)
+{
+	const int resolution = BENCHMARK_CHUNK_RESOLUTION >> level;
+	const glm::vec2 origin = { static_cast<float>(x * BENCHMARK_CHUNK_SIZE), static_cast<float>(z * BENCHMARK_CHUNK_SIZE) };
+
+	return Heightfield::Register(origin, 1.0f / resolution, BENCHMARK_CHUNK_SIZE * resolution + 1, level == 0 ? 1 + erosion.GetHalo() : 1);
+}
+
+static std::vector<uint8_t> Serialize(const Heightfield& heightfield)
+{
+	std::vector<uint8_t> payload;
+
+	RegionFile::AppendSection(payload, RegionSection::HEIGHTS, RegionCompression::PLANAR_VARINT, RegionFile::EncodeHeights(heightfield, BENCHMARK_HEIGHT_QUANTUM));
+
+	return payload;
+}
+
+static bool Load(const RegionFile& region, int x, int z, Heightfield& out)
+{
+	std::vector<uint8_t> payload;
+	RegionCompression compression = RegionCompression::NONE;
+	const uint8_t* section = nullptr;
+	size_t length = 0;
+
+	if (!region.Read(x, z, payload) || !RegionFile::FindSection(payload, RegionSection::HEIGHTS, compression, section, length) || !RegionFile::DecodeHeights(section, length, out))
+		return false;
+
+	out.RecalculateNormals();
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	std::string path = (std::filesystem::temp_directory_path() / "RegionBenchmark.region").string();
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+
+		if (argument == "--quick")
+			side = 3;
+		else if (argument == "--path" && i + 1 < argc)
+			path = argv[++i];
+		else
+		{
+			std::fprintf(stderr, "unknown argument '%s'\n", argument.c_str());
+			return 2;
+		}
+	}
+
+	const Noise noise(0.45f, 10.0f);
+	const HydraulicErosion erosion = HydraulicErosion::Register(BENCHMARK_EROSION_ITERATIONS, noise.GetSeed());
+
+	std::vector<Heightfield> generated;
+	std::filesystem::remove(path);
+
+	RegionFile region;
+
+	if (!region.Open(path, noise.GetSeed()))
+	{
+		std::fprintf(stderr, "failed to open '%s'\n", path.c_str());
+		return 2;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int z = 0; z < side; z++)
+	{
+		for (int x = 0; x < side; x++)
+		{
+			Heightfield heightfield = Prepare(erosion, x, z, 0);
+
+			heightfield.Generate(noise, BENCHMARK_CHUNK_SIZE * 4, 1.0f, 0.0f);
+			erosion.Erode(heightfield);
+			generated.push_back(std::move(heightfield));
+		}
+	}
+
+	const double generateMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / generated.size();
+
+	start = std::chrono::steady_clock::now();
+
+	size_t bytes = 0;
+
+	for (int z = 0; z < side; z++)
+	{
+		for (int x = 0; x < side; x++)
+		{
+			const std::vector<uint8_t> payload = Serialize(generated[static_cast<size_t>(z) * side + x]);
+
+			bytes += payload.size();
+			region.Write(x, z, payload);
+		}
+	}
+
+	region.Flush();
+
+	const double saveMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / generated.size();
+
+	region.Close();
+
+	if (!region.Open(path, noise.GetSeed()))
+	{
+		std::fprintf(stderr, "failed to reopen '%s'\n", path.c_str());
+		return 2;
+	}
+
+	std::vector<Heightfield> loaded;
+	bool passed = true;
+
+	start = std::chrono::steady_clock::now();
+
+	for (int z = 0; z < side; z++)
+	{
+		for (int x = 0; x < side; x++)
+		{
+			Heightfield heightfield = Prepare(erosion, x, z, 0);
+
+			passed = Load(region, x, z, heightfield) && passed;
+			loaded.push_back(std::move(heightfield));
+		}
+	}
+
+	const double loadMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / generated.size();
+
+	float maxError = 0.0f;
+
+	for (size_t i = 0; i < generated.size(); i++)
+	{
+		for (size_t j = 0; j < generated[i].heights.size(); j++)
+			maxError = std::max(maxError, std::abs(generated[i].heights[j] - loaded[i].heights[j]));
+	}
+
+	// Every coarser level reads its samples straight out of the level 0 save, apron included.
+	bool levelsMatch = true;
+
+	for (int level = 1; level < 4; level++)
+	{
+		const int factor = 1 << level;
+		Heightfield coarse = Prepare(erosion, 0, 0, level);
+
+		levelsMatch = levelsMatch && Load(region, 0, 0, coarse);
+
+		for (int z = -coarse.apron; z < coarse.resolution + coarse.apron && levelsMatch; z++)
+		{
+			for (int x = -coarse.apron; x < coarse.resolution + coarse.apron; x++)
+				levelsMatch = levelsMatch && coarse.Get(x, z) == loaded[0].Get(x * factor, z * factor);
+		}
+	}
+
+	// Grow one payload past its sectors, it moves to the end of the file and nothing else changes.
+	const size_t sizeBefore = std::filesystem::file_size(path);
+	std::vector<uint8_t> grown = Serialize(generated[0]);
+	std::vector<uint8_t> neighbour;
+
+	region.Read(1 % side, 0, neighbour);
+	grown.resize(grown.size() + REGION_SECTOR_SIZE * 2, 0);
+	region.Write(0, 0, grown);
+	region.Flush();
+
+	std::vector<uint8_t> readBack, neighbourAfter;
+	bool relocated = region.Read(0, 0, readBack) && readBack == grown && region.Read(1 % side, 0, neighbourAfter) && neighbourAfter == neighbour && std::filesystem::file_size(path) > sizeBefore;
+
+	// Every save goes to sectors the current payload doesn't use, the ones it leaves are taken by the save after, so the
+	// file grows by one copy at most.
+	const size_t sizeBeforeRewrites = std::filesystem::file_size(path);
+
+	for (int i = 0; i < 16; i++)
+	{
+		region.Write(0, 0, grown);
+		region.Flush();
+	}
+
+	const bool reused = std::filesystem::file_size(path) <= sizeBeforeRewrites + grown.size() + REGION_SECTOR_SIZE;
+
+	relocated = relocated && reused && region.Read(0, 0, readBack) && readBack == grown && region.Read(1 % side, 0, neighbourAfter) && neighbourAfter == neighbour;
+
+	// Strokes around the middle of chunk (0, 0), saved as differences from the procedural heights and loaded back on top of them.
+	Heightfield edited = generated[0];
+	EditLayer edits = EditLayer::Register(edited.origin, edited.step, edited.resolution, BENCHMARK_EDIT_APRON);
+	const TerrainBrush brushes[] = { TerrainBrush::Register(BrushMode::RAISE, 2.0f, 1.5f), TerrainBrush::Register(BrushMode::LOWER, 1.0f, 1.5f), TerrainBrush::Register(BrushMode::FLATTEN, 1.5f, 4.0f, 0.5f) };
+
+	for (int frame = 0; frame < 60; frame++)
+	{
+		const float angle = frame * 0.05f;
+
+		edits.Apply(brushes[frame % 3], glm::vec2{ 3.0f + std::cos(angle), 3.0f + std::sin(angle) }, 1.0f / 60.0f, edited);
+	}
+
+	std::vector<uint8_t> editPayload;
+
+	RegionFile::AppendSection(editPayload, RegionSection::EDITS, RegionCompression::TILE_RLE, RegionFile::EncodeEdits(edits, BENCHMARK_HEIGHT_QUANTUM));
+	region.Write(0, 0, editPayload);
+	region.Flush();
+
+	std::vector<uint8_t> editReadBack;
+	EditLayer loadedEdits = EditLayer::Register(edited.origin, edited.step, edited.resolution, BENCHMARK_EDIT_APRON);
+	Heightfield rebuilt = generated[0];
+	RegionCompression compression = RegionCompression::NONE;
+	const uint8_t* section = nullptr;
+	size_t length = 0;
+
+	bool editsLoaded = region.Read(0, 0, editReadBack) && RegionFile::FindSection(editReadBack, RegionSection::EDITS, compression, section, length) && RegionFile::DecodeEdits(section, length, loadedEdits);
+	float editError = 0.0f;
+
+	loadedEdits.AddTo(rebuilt);
+
+	for (int z = -BENCHMARK_EDIT_APRON; z < edited.resolution + BENCHMARK_EDIT_APRON; z++)
+	{
+		for (int x = -BENCHMARK_EDIT_APRON; x < edited.resolution + BENCHMARK_EDIT_APRON; x++)
+			editError = std::max(editError, std::abs(rebuilt.Get(x, z) - edited.Get(x, z)));
+	}
+
+	editsLoaded = editsLoaded && editError <= BENCHMARK_HEIGHT_QUANTUM * 0.5f + 1e-5f;
+
+	region.Close();
+	std::filesystem::remove(path);
+
+	const double raw = static_cast<double>(generated[0].heights.size() * sizeof(float));
+
+	passed = passed && maxError <= BENCHMARK_HEIGHT_QUANTUM * 0.5f + 1e-6f && levelsMatch && relocated && loadMilliseconds < generateMilliseconds && editsLoaded;
+
+	std::printf("{\n  \"chunks\": %zu,\n  \"generateMs\": %.3f,\n  \"saveMs\": %.3f,\n  \"loadMs\": %.3f,\n  \"speedup\": %.1f,\n", generated.size(), generateMilliseconds, saveMilliseconds, loadMilliseconds, generateMilliseconds / loadMilliseconds);
+	std::printf("  \"bytesPerChunk\": %.0f,\n  \"rawBytesPerChunk\": %.0f,\n  \"maxError\": %.6f,\n  \"levelsMatch\": %s,\n  \"relocated\": %s,\n", static_cast<double>(bytes) / generated.size(), raw, maxError, levelsMatch ? "true" : "false", relocated ? "true" : "false");
+	std::printf("  \"editTiles\": %zu,\n  \"editTileBytes\": %zu,\n  \"editBytes\": %zu,\n  \"editMaxError\": %.6f,\n  \"passed\": %s\n}\n", edits.tiles.size(), edits.tiles.size() * sizeof(EditLayer::Tile), editPayload.size(), editError, passed ? "true" : "false");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
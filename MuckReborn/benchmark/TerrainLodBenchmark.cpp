@@ -0,0 +1,294 @@
+// Standalone, no window or GL context required, only glm on the include path:
+// g++ -std=c++17 -O2 -pthread -IMuckReborn/include MuckReborn/benchmark/TerrainLodBenchmark.cpp -o TerrainLodBenchmark
+//
+// ./TerrainLodBenchmark [--quick]
+//
+// Flies a camera in a straight line over the terrain at several view distances, keeping the chunks around it at the
+// level TerrainLod picks the way World::Update does, and prints one JSON document with the triangle count on screen
+// and the CPU frame time spent generating chunks that came into range or changed level. Flat is the triangle count
+// the same chunks would have at level 0. The exit code is non-zero when a level's morph range is empty or falls outside
+// its range, when the levels draw more triangles than level 0 everywhere would, or when a level's noise tier can be off by
+// more than the allowed screen error, or when a tier measured on a few chunks against FULL exceeds its bound. The bound
+// in pixels of both coarser tiers is printed per level, as the screen error each would need to be picked.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "world/BiomeMap.hpp"
+#include "world/Erosion.hpp"
+#include "world/Heightfield.hpp"
+#include "world/TerrainLod.hpp"
+
+// Mirrors world/Chunk.hpp, which pulls in the renderer.
+#define BENCHMARK_CHUNK_SIZE 6
+#define BENCHMARK_CHUNK_RESOLUTION 8
+#define BENCHMARK_LOD_LEVELS 4
+#define BENCHMARK_LOD_DISTANCE 24.0f
+#define BENCHMARK_EROSION_ITERATIONS 4096
+#define BENCHMARK_QUALITY_PIXELS 2.0f
+#define BENCHMARK_QUALITY_SCREEN_HEIGHT 1080.0f
+#define BENCHMARK_QUALITY_FOV 45.0f
+
+// Mirrors WORLD_LOAD_RADIUS in world/World.hpp, in chunks.
+#define BENCHMARK_LOAD_RADIUS 12
+
+#define BENCHMARK_SPEED 0.5f
+
+struct FlythroughResult
+{
+	float viewDistance;
+	size_t chunks;
+	double triangles;
+	size_t maxTriangles;
+	double flatTriangles;
+	double milliseconds;
+	double maxMilliseconds;
+	double loadMilliseconds;
+	size_t levelChanges;
+};
+
+static int frames = 240;
+
+// Same count as TerrainMesher<Size, Resolution>::TriangleCount: two per cell and two per skirt segment.
+static size_t GetTriangleCount(int level)
+{
+	const size_t cells = static_cast<size_t>(BENCHMARK_CHUNK_SIZE) * (BENCHMARK_CHUNK_RESOLUTION >> level);
+
+	return cells * cells * 2 + cells * 8;
+}
+
+// Same as Chunk::SelectQuality.
+static NoiseQuality SelectQuality(const Noise& noise, const TerrainLod& lod, int level)
+{
+	if (level <= 0)
+		return NoiseQuality::FULL;
+
+	const float maxError = lod.GetScreenError(level, BENCHMARK_QUALITY_PIXELS, BENCHMARK_QUALITY_SCREEN_HEIGHT, glm::radians(BENCHMARK_QUALITY_FOV));
+
+	return noise.SelectQuality(BENCHMARK_CHUNK_SIZE * 4, 1.0f / (BENCHMARK_CHUNK_RESOLUTION >> level), maxError);
+}
+
+// Height error in pixels on screen at the nearest a chunk of level gets, zero for level 0, which is never coarsened.
+static float GetScreenPixels(const TerrainLod& lod, int level, float error)
+{
+	const float pixel = lod.GetScreenError(level, 1.0f, BENCHMARK_QUALITY_SCREEN_HEIGHT, glm::radians(BENCHMARK_QUALITY_FOV));
+
+	return pixel > 0.0f ? error / pixel : 0.0f;
+}
+
+// Largest difference between a chunk at level generated at quality and the same chunk at FULL, over a few chunks.
+static float MeasureQualityError(const Noise& noise, int level, NoiseQuality quality)
+{
+	const int resolution = BENCHMARK_CHUNK_RESOLUTION >> level;
+	float out = 0.0f;
+
+	for (int i = 0; i < 8; i++)
+	{
+		const glm::vec2 origin = { static_cast<float>((i * 5 - 17) * BENCHMARK_CHUNK_SIZE), static_cast<float>((i * 3 - 11) * BENCHMARK_CHUNK_SIZE) };
+
+		Heightfield full = Heightfield::Register(origin, 1.0f / resolution, BENCHMARK_CHUNK_SIZE * resolution + 1, 1);
+		Heightfield tier = full;
+
+		full.Generate(noise, BENCHMARK_CHUNK_SIZE * 4, 1.0f, 0.0f);
+		tier.Generate(noise, BENCHMARK_CHUNK_SIZE * 4, 1.0f, 0.0f, quality);
+
+		for (size_t j = 0; j < full.heights.size(); j++)
+			out = std::max(out, std::fabs(tier.heights[j] - full.heights[j]));
+	}
+
+	return out;
+}
+
+static const char* GetQualityName(NoiseQuality quality)
+{
+	switch (quality)
+	{
+	case NoiseQuality::REDUCED: return "reduced";
+	case NoiseQuality::APPROXIMATE: return "approximate";
+	default: return "full";
+	}
+}
+
+// The CPU half of Chunk::Prepare and Chunk::Generate at a level, without the vertex fill.
+static void GenerateChunk(const Noise& noise, const BiomeMap& biomeMap, const TerrainLod& lod, int x, int z, int level)
+{
+	const int resolution = BENCHMARK_CHUNK_RESOLUTION >> level;
+	const float step = 1.0f / resolution;
+	const glm::vec2 origin = { static_cast<float>(x * BENCHMARK_CHUNK_SIZE), static_cast<float>(z * BENCHMARK_CHUNK_SIZE) };
+	const HydraulicErosion erosion = HydraulicErosion::Register(BENCHMARK_EROSION_ITERATIONS, noise.GetSeed());
+	const NoiseQuality quality = SelectQuality(noise, lod, level);
+
+	Heightfield heightfield = Heightfield::Register(origin, step, BENCHMARK_CHUNK_SIZE * resolution + 1, level == 0 ? 1 + erosion.GetHalo() : 1);
+	BiomeTile biomes = BiomeTile::Register(origin, step, BENCHMARK_CHUNK_SIZE * resolution + 1);
+
+	heightfield.Generate(noise, BENCHMARK_CHUNK_SIZE * 4, 1.0f, 0.0f, quality);
+
+	if (level == 0)
+		erosion.Erode(heightfield);
+
+	biomeMap.Generate(noise, biomes);
+}
+
+static FlythroughResult Run(const Noise& noise, const BiomeMap& biomeMap, const TerrainLod& lod, float viewDistance)
+{
+	const int loadRadius = static_cast<int>(std::ceil(viewDistance / BENCHMARK_CHUNK_SIZE));
+	const int unloadRadius = loadRadius + 2;
+	const glm::vec2 direction = glm::normalize(glm::vec2{ 1.0f, 0.35f });
+
+	std::map<std::pair<int, int>, int> levels;
+	FlythroughResult out = { viewDistance, 0, 0.0, 0, 0.0, 0.0, 0.0, 0.0, 0 };
+
+	for (int frame = -1; frame < frames; frame++)
+	{
+		const glm::vec2 position = direction * (BENCHMARK_SPEED * static_cast<float>(std::max(frame, 0)));
+		const int centerX = static_cast<int>(std::floor(position.x / BENCHMARK_CHUNK_SIZE));
+		const int centerZ = static_cast<int>(std::floor(position.y / BENCHMARK_CHUNK_SIZE));
+
+		for (auto iterator = levels.begin(); iterator != levels.end();)
+		{
+			const int x = iterator->first.first - centerX;
+			const int z = iterator->first.second - centerZ;
+
+			if (x * x + z * z > unloadRadius * unloadRadius)
+				iterator = levels.erase(iterator);
+			else
+				++iterator;
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+
+		for (int z = -loadRadius; z <= loadRadius; z++)
+		{
+			for (int x = -loadRadius; x <= loadRadius; x++)
+			{
+				if (x * x + z * z > loadRadius * loadRadius)
+					continue;
+
+				const std::pair<int, int> coordinate = { centerX + x, centerZ + z };
+				const glm::vec2 middle = glm::vec2{ static_cast<float>(coordinate.first), static_cast<float>(coordinate.second) } * static_cast<float>(BENCHMARK_CHUNK_SIZE) + BENCHMARK_CHUNK_SIZE * 0.5f;
+				const float distance = glm::length(middle - position);
+				const auto existing = levels.find(coordinate);
+				const int level = lod.SelectLevel(distance, existing == levels.end() ? -1 : existing->second);
+
+				if (existing != levels.end() && existing->second == level)
+					continue;
+
+				if (existing != levels.end() && frame >= 0)
+					out.levelChanges++;
+
+				GenerateChunk(noise, biomeMap, lod, coordinate.first, coordinate.second, level);
+				levels[coordinate] = level;
+			}
+		}
+
+		const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// Frame -1 loads everything around the starting point, like the first frames after InitalizeWorld.
+		if (frame < 0)
+		{
+			out.loadMilliseconds = milliseconds;
+			continue;
+		}
+
+		size_t triangles = 0;
+
+		for (const auto& [coordinate, level] : levels)
+			triangles += GetTriangleCount(level);
+
+		out.chunks = std::max(out.chunks, levels.size());
+		out.triangles += static_cast<double>(triangles) / frames;
+		out.maxTriangles = std::max(out.maxTriangles, triangles);
+		out.flatTriangles += static_cast<double>(levels.size() * GetTriangleCount(0)) / frames;
+		out.milliseconds += milliseconds / frames;
+		out.maxMilliseconds = std::max(out.maxMilliseconds, milliseconds);
+	}
+
+	return out;
+}
+
+static bool IsMorphRangeValid(const TerrainLod& lod, int level)
+{
+	const glm::vec2 range = lod.GetMorphRange(level);
+
+	if (level == lod.levels - 1)
+		return range.x > 1.0e30f;
+
+	return range.x < range.y && range.x >= lod.GetRange(level - 1) && range.y <= lod.GetRange(level);
+}
+
+int main(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+
+		if (argument == "--quick")
+			frames = 40;
+		else
+		{
+			std::fprintf(stderr, "unknown argument '%s'\n", argument.c_str());
+			return 2;
+		}
+	}
+
+	const Noise noise(0.45f, 10.0f);
+	const TerrainLod lod = TerrainLod::Register(BENCHMARK_CHUNK_SIZE, BENCHMARK_LOD_DISTANCE, BENCHMARK_LOD_LEVELS);
+	const float viewDistances[] = { 24.0f, 48.0f, 96.0f, 192.0f };
+
+	BiomeMap biomeMap = BiomeMap::Register(0.02f, 0.2f);
+
+	bool passed = true;
+	bool withinScreenError = true;
+
+	std::printf("{\n  \"frames\": %d,\n  \"levels\": [\n", frames);
+
+	for (int level = 0; level < lod.levels; level++)
+	{
+		const glm::vec2 range = lod.GetMorphRange(level);
+		const bool valid = IsMorphRangeValid(lod, level);
+		const NoiseQuality quality = SelectQuality(noise, lod, level);
+		const float step = 1.0f / (BENCHMARK_CHUNK_RESOLUTION >> level);
+
+		// A chunk is loaded when its centre is within the load radius, the level has to start inside that.
+		const bool reachable = lod.GetRange(level - 1) < BENCHMARK_LOAD_RADIUS * BENCHMARK_CHUNK_SIZE;
+
+		const float bound = noise.GetQualityError(quality, BENCHMARK_CHUNK_SIZE * 4, step);
+		const float boundPixels = GetScreenPixels(lod, level, bound);
+		float tierPixels[2] = {};
+
+		for (NoiseQuality tier : { NoiseQuality::REDUCED, NoiseQuality::APPROXIMATE })
+		{
+			const float tierBound = noise.GetQualityError(tier, BENCHMARK_CHUNK_SIZE * 4, step);
+
+			withinScreenError = withinScreenError && MeasureQualityError(noise, level, tier) <= tierBound;
+			tierPixels[tier == NoiseQuality::APPROXIMATE] = GetScreenPixels(lod, level, tierBound);
+		}
+
+		passed = passed && valid;
+		withinScreenError = withinScreenError && boundPixels <= BENCHMARK_QUALITY_PIXELS;
+
+		std::printf("    { \"level\": %d, \"resolution\": %d, \"trianglesPerChunk\": %zu, \"range\": %.1f, \"morphStart\": %.2f, \"morphEnd\": %.2f, \"valid\": %s, \"quality\": \"%s\", \"qualityError\": %.4f, \"boundPixels\": %.3f, \"reducedPixels\": %.3f, \"approximatePixels\": %.3f, \"reachable\": %s }%s\n", level, BENCHMARK_CHUNK_RESOLUTION >> level, GetTriangleCount(level), level == lod.levels - 1 ? -1.0f : lod.GetRange(level), level == lod.levels - 1 ? -1.0f : range.x, level == lod.levels - 1 ? -1.0f : range.y, valid ? "true" : "false", GetQualityName(quality), bound, boundPixels, tierPixels[0], tierPixels[1], reachable ? "true" : "false", level + 1 < lod.levels ? "," : "");
+	}
+
+	passed = passed && withinScreenError;
+
+	std::printf("  ],\n  \"withinScreenError\": %s,\n  \"flythroughs\": [\n", withinScreenError ? "true" : "false");
+
+	for (size_t i = 0; i < sizeof(viewDistances) / sizeof(viewDistances[0]); i++)
+	{
+		const FlythroughResult result = Run(noise, biomeMap, lod, viewDistances[i]);
+
+		passed = passed && result.triangles <= result.flatTriangles;
+
+		std::printf("    { \"viewDistance\": %.0f, \"chunks\": %zu, \"triangles\": %.0f, \"maxTriangles\": %zu, \"flatTriangles\": %.0f, \"frameMs\": %.3f, \"maxFrameMs\": %.3f, \"loadMs\": %.1f, \"levelChanges\": %zu }%s\n", result.viewDistance, result.chunks, result.triangles, result.maxTriangles, result.flatTriangles, result.milliseconds, result.maxMilliseconds, result.loadMilliseconds, result.levelChanges, i + 1 < sizeof(viewDistances) / sizeof(viewDistances[0]) ? "," : "");
+	}
+
+	std::printf("  ],\n  \"passed\": %s\n}\n", passed ? "true" : "false");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,185 @@
+// Standalone, no window or GL context required, only glm on the include path:
+// g++ -std=c++17 -O2 -IMuckReborn/include MuckReborn/benchmark/VoxelMeshBenchmark.cpp -o VoxelMeshBenchmark
+//
+// ./VoxelMeshBenchmark [--quick]
+//
+// Fills voxel chunks four ways, terrain columns the way VoxelChunk::GenerateTerrain does, caves cut by 3D noise, one solid
+// block type and a checkerboard, stores them in PaletteStorage and meshes them with VoxelMesher. Prints one JSON document
+// with the quads against one quad per visible face, the meshing time and the bytes of block storage per chunk. The exit
+// code is non-zero when the storage doesn't read back what was written, the quads don't cover every visible face exactly
+// once, or a uniform chunk isn't stored as a single palette entry.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include "math/Noise.hpp"
+#include "world/PaletteStorage.hpp"
+#include "world/VoxelMesher.hpp"
+
+// Mirrors world/VoxelChunk.hpp, which pulls in the renderer.
+#define BENCHMARK_CHUNK_SIZE 6
+#define BENCHMARK_VOXEL_SIZE 16
+#define BENCHMARK_BLOCK_SIZE (static_cast<float>(BENCHMARK_CHUNK_SIZE) / BENCHMARK_VOXEL_SIZE)
+
+using Mesher = VoxelMesher<BENCHMARK_VOXEL_SIZE>;
+
+struct MeshResult
+{
+	std::string name;
+	size_t chunks;
+	double faces;
+	double quads;
+	double milliseconds;
+	double storageBytes;
+	double paletteBits;
+	bool exact;
+};
+
+static int side = 4;
+
+static size_t GetIndex(int x, int y, int z)
+{
+	return (static_cast<size_t>(z) * BENCHMARK_VOXEL_SIZE + y) * BENCHMARK_VOXEL_SIZE + x;
+}
+
+// Block at world block coordinates, so the padding of each chunk comes from the same function as its neighbours.
+static MeshResult Run(const std::string& name, const std::function<BlockType(int, int, int)>& block)
+{
+	MeshResult out = { name, 0, 0.0, 0.0, 0.0, 0.0, 0.0, true };
+	std::vector<BlockType> padded(Mesher::PaddedCount);
+	std::vector<VoxelQuad> quads;
+
+	for (int chunkZ = 0; chunkZ < side; chunkZ++)
+	{
+		for (int chunkX = 0; chunkX < side; chunkX++)
+		{
+			const int baseX = chunkX * BENCHMARK_VOXEL_SIZE;
+			const int baseZ = chunkZ * BENCHMARK_VOXEL_SIZE;
+
+			PaletteStorage storage = PaletteStorage::Register(BENCHMARK_VOXEL_SIZE * BENCHMARK_VOXEL_SIZE * BENCHMARK_VOXEL_SIZE);
+
+			for (int z = -1; z <= BENCHMARK_VOXEL_SIZE; z++)
+			{
+				for (int y = -1; y <= BENCHMARK_VOXEL_SIZE; y++)
+				{
+					for (int x = -1; x <= BENCHMARK_VOXEL_SIZE; x++)
+					{
+						const BlockType type = block(baseX + x, y, baseZ + z);
+						const bool inside = x >= 0 && y >= 0 && z >= 0 && x < BENCHMARK_VOXEL_SIZE && y < BENCHMARK_VOXEL_SIZE && z < BENCHMARK_VOXEL_SIZE;
+
+						padded[Mesher::GetPaddedIndex(x, y, z)] = type;
+
+						if (inside)
+							storage.Set(GetIndex(x, y, z), type);
+					}
+				}
+			}
+
+			storage.Compact();
+
+			for (int z = 0; z < BENCHMARK_VOXEL_SIZE; z++)
+			{
+				for (int y = 0; y < BENCHMARK_VOXEL_SIZE; y++)
+				{
+					for (int x = 0; x < BENCHMARK_VOXEL_SIZE; x++)
+						out.exact = out.exact && storage.Get(GetIndex(x, y, z)) == padded[Mesher::GetPaddedIndex(x, y, z)];
+				}
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+
+			Mesher::Generate(padded.data(), quads);
+
+			const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			const size_t faces = Mesher::CountFaces(padded.data());
+			size_t covered = 0;
+
+			for (const VoxelQuad& quad : quads)
+				covered += static_cast<size_t>(quad.width) * quad.height;
+
+			out.exact = out.exact && covered == faces;
+			out.chunks++;
+			out.faces += static_cast<double>(faces);
+			out.quads += static_cast<double>(quads.size());
+			out.milliseconds += milliseconds;
+			out.storageBytes += static_cast<double>(storage.GetMemoryUsage());
+			out.paletteBits += storage.GetBits();
+		}
+	}
+
+	out.faces /= out.chunks;
+	out.quads /= out.chunks;
+	out.milliseconds /= out.chunks;
+	out.storageBytes /= out.chunks;
+	out.paletteBits /= out.chunks;
+
+	return out;
+}
+
+int main(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+
+		if (argument == "--quick")
+			side = 2;
+		else
+		{
+			std::fprintf(stderr, "unknown argument '%s'\n", argument.c_str());
+			return 2;
+		}
+	}
+
+	const Noise noise(0.45f, 10.0f);
+
+	auto Terrain = [&](int x, int y, int z)
+	{
+		const float height = noise.FractalNoise(BENCHMARK_CHUNK_SIZE * 4, (x + 0.5f) * BENCHMARK_BLOCK_SIZE, (z + 0.5f) * BENCHMARK_BLOCK_SIZE) * 2.0f + 3.0f;
+		const int top = static_cast<int>(std::floor(height / BENCHMARK_BLOCK_SIZE));
+
+		if (y > top)
+			return BlockType::AIR;
+
+		if (y == top)
+			return height < 0.05f ? BlockType::SAND : BlockType::GRASS;
+
+		return y >= top - 2 ? BlockType::DIRT : BlockType::STONE;
+	};
+
+	auto Caves = [&](int x, int y, int z)
+	{
+		return noise.FractalNoise(4, x * 0.08f, y * 0.08f, z * 0.08f) > 0.0f ? BlockType::STONE : BlockType::AIR;
+	};
+
+	const MeshResult results[] =
+	{
+		Run("terrain", Terrain),
+		Run("caves", Caves),
+		Run("solid", [](int, int, int) { return BlockType::STONE; }),
+		Run("checkerboard", [](int x, int y, int z) { return ((x + y + z) & 1) ? BlockType::DIRT : BlockType::AIR; })
+	};
+
+	bool passed = true;
+
+	std::printf("{\n  \"chunkSize\": %d,\n  \"results\": [\n", BENCHMARK_VOXEL_SIZE);
+
+	for (size_t i = 0; i < sizeof(results) / sizeof(results[0]); i++)
+	{
+		const MeshResult& result = results[i];
+
+		passed = passed && result.exact && result.quads <= result.faces;
+
+		std::printf("    { \"name\": \"%s\", \"chunks\": %zu, \"faces\": %.0f, \"quads\": %.0f, \"reduction\": %.1f, \"meshMs\": %.3f, \"storageBytes\": %.0f, \"paletteBits\": %.1f, \"exact\": %s }%s\n", result.name.c_str(), result.chunks, result.faces, result.quads, result.quads > 0.0 ? result.faces / result.quads : 0.0, result.milliseconds, result.storageBytes, result.paletteBits, result.exact ? "true" : "false", i + 1 < sizeof(results) / sizeof(results[0]) ? "," : "");
+	}
+
+	// The solid chunk has to stay one palette entry and no packed words.
+	passed = passed && results[2].paletteBits == 0.0 && results[2].storageBytes < 256.0;
+
+	std::printf("  ],\n  \"passed\": %s\n}\n", passed ? "true" : "false");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+
+public:
+
+	explicit ThreadPool(size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency()))
+	{
+		for (size_t i = 0; i < threadCount; i++)
+			workers.emplace_back([this]() { WorkerLoop(); });
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+
+		condition.notify_all();
+
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+
+	void Submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push_back(std::move(task));
+		}
+
+		condition.notify_one();
+	}
+
+	// Runs function(0..count-1) across the workers and the calling thread, returns once every index has run.
+	template<typename Function>
+	void ParallelFor(size_t count, Function&& function)
+	{
+		if (count == 0)
+			return;
+
+		struct State
+		{
+			std::atomic<size_t> next = { 0 };
+			std::atomic<size_t> remaining = { 0 };
+			std::mutex mutex;
+			std::condition_variable done;
+		};
+
+		auto state = std::make_shared<State>();
+		state->remaining = count;
+
+		auto Run = [state, &function, count]()
+		{
+			for (size_t index = state->next.fetch_add(1); index < count; index = state->next.fetch_add(1))
+			{
+				function(index);
+
+				if (state->remaining.fetch_sub(1) == 1)
+				{
+					std::lock_guard<std::mutex> lock(state->mutex);
+					state->done.notify_all();
+				}
+			}
+		};
+
+		const size_t helpers = std::min(workers.size(), count - 1);
+
+		for (size_t i = 0; i < helpers; i++)
+			Submit(Run);
+
+		Run();
+
+		std::unique_lock<std::mutex> lock(state->mutex);
+		state->done.wait(lock, [&]() { return state->remaining.load() == 0; });
+	}
+
+	size_t GetThreadCount() const
+	{
+		return workers.size();
+	}
+
+private:
+
+	void WorkerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> task;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+				if (stopping && tasks.empty())
+					return;
+
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool stopping = false;
+};
+
+#endif // !THREAD_POOL_HPP
\ No newline at end of file
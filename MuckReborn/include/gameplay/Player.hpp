@@ -3,6 +3,11 @@
 
 #include "rendering/Camera.hpp"
 #include "rendering/Renderer.hpp"
+#include "world/World.hpp"
+
+// How far away the terrain under the crosshair can be edited. Only level 0 chunks take edits, this keeps the brush's
+// chunks inside CHUNK_LOD_DISTANCE less the hysteresis margin, the brush's reach and half a chunk diagonal.
+#define PLAYER_EDIT_DISTANCE 14.0f
 
 struct PlayerData
 {
@@ -13,6 +18,7 @@ struct PlayerData
 struct Player
 {
 	PlayerData data;
+	TerrainBrush brush = TerrainBrush::Register(BrushMode::RAISE, 2.0f, 1.5f);
 
 	void InitalizePlayer(const glm::vec3& position)
 	{
@@ -35,12 +41,29 @@ struct Player
 		UpdateMovement();
 	}
 
+	// Left mouse raises and right mouse lowers the terrain under the crosshair, F flattens it to the height it was first pressed on.
 	void UpdateBlockEditing()
 	{
+		const bool flattenStarted = Input::GetKeyJustPressed(GLFW_KEY_F);
+
 		if (Input::GetMouseButtonDown(0))
-		{
-			
-		}
+			brush.mode = BrushMode::RAISE;
+		else if (Input::GetMouseButtonDown(1))
+			brush.mode = BrushMode::LOWER;
+		else if (Input::GetKeyDown(GLFW_KEY_F))
+			brush.mode = BrushMode::FLATTEN;
+		else
+			return;
+
+		glm::vec3 hit = { 0.0f, 0.0f, 0.0f };
+
+		if (!World::Raycast(data.transform.position, data.camera.data.transform.rotation, PLAYER_EDIT_DISTANCE, hit))
+			return;
+
+		if (flattenStarted)
+			brush.target = hit.y;
+
+		World::ApplyBrush(brush, { hit.x, hit.z }, Window::mainWindow.data.deltaTime);
 	}
 
 	void UpdateDebugControls()
@@ -0,0 +1,189 @@
+#ifndef FIXED_NOISE_HPP
+#define FIXED_NOISE_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include "math/Noise.hpp"
+
+// Coordinates and results are 16.16 fixed point, the evaluation runs in 40.24.
+#define FIXED_NOISE_FRACTION_BITS 16
+#define FIXED_NOISE_ONE (1 << FIXED_NOISE_FRACTION_BITS)
+#define FIXED_NOISE_INTERNAL_BITS 24
+#define FIXED_NOISE_INTERNAL_ONE (int64_t(1) << FIXED_NOISE_INTERNAL_BITS)
+
+// Integer only simplex and fractal noise. Every operation is an integer add, multiply or floor shift, so the output
+// is bit-exact across compilers, flags and platforms, and a seed is enough to regenerate the same terrain anywhere.
+// It follows Noise's 2D simplex closely but is a separate function, its output is not bit-identical to the float one.
+// |coordinate * frequency| must stay below 2^38 for every octave, which covers 24 octaves over +-32768 units.
+class FixedNoise
+{
+
+public:
+
+    explicit FixedNoise(const Noise& noise)
+    {
+        const FractalParameters parameters = noise.GetFractalParameters(0);
+
+        for (int32_t i = 0; i < 512; i++)
+            mPermutation[i] = parameters.permutation[i];
+
+        mFrequency = ToInternal(parameters.frequency);
+        mAmplitude = ToInternal(parameters.amplitude);
+        mLacunarity = ToInternal(parameters.lacunarity);
+        mPersistence = ToInternal(parameters.persistence);
+        mSeed = noise.GetSeed();
+    }
+
+    int32_t SimplexNoise(int32_t x, int32_t y) const
+    {
+        return ToOutput(Simplex(static_cast<int64_t>(x) * (1 << (FIXED_NOISE_INTERNAL_BITS - FIXED_NOISE_FRACTION_BITS)), static_cast<int64_t>(y) * (1 << (FIXED_NOISE_INTERNAL_BITS - FIXED_NOISE_FRACTION_BITS))));
+    }
+
+    int32_t FractalNoise(size_t octaves, int32_t x, int32_t y) const
+    {
+        const int64_t internalX = static_cast<int64_t>(x) * (1 << (FIXED_NOISE_INTERNAL_BITS - FIXED_NOISE_FRACTION_BITS));
+        const int64_t internalY = static_cast<int64_t>(y) * (1 << (FIXED_NOISE_INTERNAL_BITS - FIXED_NOISE_FRACTION_BITS));
+
+        int64_t output = 0;
+        int64_t denom = 0;
+        int64_t frequency = mFrequency;
+        int64_t amplitude = mAmplitude;
+
+        for (size_t octave = 0; octave < octaves; octave++)
+        {
+            output += amplitude * Simplex(Multiply(internalX, frequency), Multiply(internalY, frequency));
+            denom += amplitude;
+
+            frequency = Multiply(frequency, mLacunarity);
+            amplitude = Multiply(amplitude, mPersistence);
+        }
+
+        if (denom == 0)
+            return 0;
+
+        return ToOutput(output / denom);
+    }
+
+    // Row major, sample (x, z) is at (originX + x * step, originZ + z * step).
+    void FillGrid2D(int32_t originX, int32_t originZ, int32_t step, size_t width, size_t height, size_t octaves, int32_t* out) const
+    {
+        for (size_t z = 0; z < height; z++)
+        {
+            const int32_t y = originZ + static_cast<int32_t>(z) * step;
+
+            for (size_t x = 0; x < width; x++)
+                out[z * width + x] = FractalNoise(octaves, originX + static_cast<int32_t>(x) * step, y);
+        }
+    }
+
+    uint32_t GetSeed() const
+    {
+        return mSeed;
+    }
+
+    static int32_t ToFixed(float value)
+    {
+        return static_cast<int32_t>(std::llround(static_cast<double>(value) * FIXED_NOISE_ONE));
+    }
+
+    static float ToFloat(int32_t value)
+    {
+        return static_cast<float>(value) * (1.0f / FIXED_NOISE_ONE);
+    }
+
+private:
+
+    // Floor of value / 2^bits, right shifts of negative values are implementation defined before C++20.
+    static int64_t FloorShift(int64_t value, int bits)
+    {
+        return value >= 0 ? (value >> bits) : ~((~value) >> bits);
+    }
+
+    // Floor of a * b / 2^24 without overflowing when only the result fits, a and b are split into whole and fraction.
+    static int64_t Multiply(int64_t a, int64_t b)
+    {
+        const int64_t aWhole = FloorShift(a, FIXED_NOISE_INTERNAL_BITS);
+        const int64_t aFraction = a - aWhole * FIXED_NOISE_INTERNAL_ONE;
+        const int64_t bWhole = FloorShift(b, FIXED_NOISE_INTERNAL_BITS);
+        const int64_t bFraction = b - bWhole * FIXED_NOISE_INTERNAL_ONE;
+
+        return aWhole * b + aFraction * bWhole + FloorShift(aFraction * bFraction, FIXED_NOISE_INTERNAL_BITS);
+    }
+
+    static int64_t ToInternal(float value)
+    {
+        return std::llround(static_cast<double>(value) * FIXED_NOISE_INTERNAL_ONE);
+    }
+
+    static int32_t ToOutput(int64_t value)
+    {
+        return static_cast<int32_t>(FloorShift(value, FIXED_NOISE_INTERNAL_BITS - FIXED_NOISE_FRACTION_BITS));
+    }
+
+    static int64_t Gradient(int32_t hash, int64_t x, int64_t y)
+    {
+        const int32_t h = hash & 0x3F;
+        const int64_t u = h < 4 ? x : y;
+        const int64_t v = h < 4 ? y : x;
+
+        return ((h & 1) ? -u : u) + ((h & 2) ? -2 * v : 2 * v);
+    }
+
+    static int64_t Corner(int64_t x, int64_t y, int32_t hash)
+    {
+        int64_t t = FIXED_NOISE_INTERNAL_ONE / 2 - Multiply(x, x) - Multiply(y, y);
+
+        if (t < 0)
+            return 0;
+
+        t = Multiply(t, t);
+
+        return Multiply(Multiply(t, t), Gradient(hash, x, y));
+    }
+
+    // 40.24 in and out. Works on the fractional part of the skewed coordinates so large inputs keep their precision.
+    int64_t Simplex(int64_t x, int64_t y) const
+    {
+        static const int64_t F2 = 6140887;
+        static const int64_t G2 = 3545443;
+        static const int64_t Scale = 758844385;
+
+        const int64_t s = Multiply(x + y, F2);
+        const int64_t xs = x + s;
+        const int64_t ys = y + s;
+        const int64_t i = FloorShift(xs, FIXED_NOISE_INTERNAL_BITS);
+        const int64_t j = FloorShift(ys, FIXED_NOISE_INTERNAL_BITS);
+        const int64_t fx = xs - i * FIXED_NOISE_INTERNAL_ONE;
+        const int64_t fy = ys - j * FIXED_NOISE_INTERNAL_ONE;
+
+        const int64_t t = Multiply(fx + fy, G2);
+        const int64_t x0 = fx - t;
+        const int64_t y0 = fy - t;
+
+        const int32_t i1 = x0 > y0 ? 1 : 0;
+        const int32_t j1 = 1 - i1;
+
+        const int32_t ii = static_cast<int32_t>(i & 255);
+        const int32_t jj = static_cast<int32_t>(j & 255);
+
+        const int32_t gi0 = mPermutation[ii + mPermutation[jj]];
+        const int32_t gi1 = mPermutation[ii + i1 + mPermutation[jj + j1]];
+        const int32_t gi2 = mPermutation[ii + 1 + mPermutation[jj + 1]];
+
+        const int64_t n0 = Corner(x0, y0, gi0);
+        const int64_t n1 = Corner(x0 - i1 * FIXED_NOISE_INTERNAL_ONE + G2, y0 - j1 * FIXED_NOISE_INTERNAL_ONE + G2, gi1);
+        const int64_t n2 = Corner(x0 - FIXED_NOISE_INTERNAL_ONE + 2 * G2, y0 - FIXED_NOISE_INTERNAL_ONE + 2 * G2, gi2);
+
+        return Multiply(n0 + n1 + n2, Scale);
+    }
+
+    int32_t mPermutation[512];
+    int64_t mFrequency;
+    int64_t mAmplitude;
+    int64_t mLacunarity;
+    int64_t mPersistence;
+    uint32_t mSeed;
+};
+
+#endif // !FIXED_NOISE_HPP
\ No newline at end of file
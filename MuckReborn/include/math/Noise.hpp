@@ -1,8 +1,25 @@
 #ifndef NOISE_HPP
 #define NOISE_HPP
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "core/ThreadPool.hpp"
+#include "math/NoiseSIMD.hpp"
+
+#define FRACTAL_MAX_OCTAVES 32
+#define NOISE_TILE_BAND_ROWS 16
+#define NOISE_APPROXIMATE_STRIDE 4
+
+// Upper bounds on |SimplexNoise(x, y)| and on its second partial derivatives along x and y, the measured maxima are
+// 0.99999 and 51.9.
+#define NOISE_SIMPLEX_2D_BOUND 1.001f
+#define NOISE_SIMPLEX_2D_CURVATURE_BOUND 54.0f
 
 static inline int32_t FastFloor(float fp) 
 {
@@ -27,11 +44,6 @@ static const uint8_t perm[256] =
     138, 236, 205, 93, 222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180
 };
 
-static inline uint8_t Hash(int32_t i) 
-{
-    return perm[static_cast<uint8_t>(i)];
-}
-
 static float Gradient(int32_t Hash, float x) 
 {
     const int32_t h = Hash & 0x0F;
@@ -50,6 +62,16 @@ static float Gradient(int32_t Hash, float x, float y)
     return ((h & 1) ? -u : u) + ((h & 2) ? -2.0f * v : 2.0f * v);
 }
 
+static void GradientCoefficients(int32_t Hash, float& gx, float& gy)
+{
+    const int32_t h = Hash & 0x3F;
+    const float u = (h & 1) ? -1.0f : 1.0f;
+    const float v = (h & 2) ? -2.0f : 2.0f;
+
+    gx = h < 4 ? u : v;
+    gy = h < 4 ? v : u;
+}
+
 static float Gradient(int32_t Hash, float x, float y, float z) 
 {
     int h = Hash & 15;
@@ -59,12 +81,106 @@ static float Gradient(int32_t Hash, float x, float y, float z)
     return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
 }
 
+struct NoiseSample
+{
+    float value = 0.f;
+    float dx = 0.f;
+    float dy = 0.f;
+};
+
+// Distances to the nearest and second nearest feature point (F2 - F1 gives the cell border distance)
+// and the hashes of the cells they belong to.
+struct CellularSample
+{
+    float f1 = 0.f;
+    float f2 = 0.f;
+    int32_t id1 = 0;
+    int32_t id2 = 0;
+};
+
+// Quality tiers for FillGrid2D. REDUCED drops the octaves above the grid's Nyquist limit, APPROXIMATE evaluates the
+// octaves a world aligned lattice NOISE_APPROXIMATE_STRIDE samples apart can interpolate closer than dropping them would
+// and interpolates it bilinearly. Either may drop every octave, which leaves the fractal's mean of 0. Both keep the FULL
+// normalization, GetQualityError bounds how far they can stray from FULL and never exceeds NOISE_SIMPLEX_2D_BOUND.
+enum class NoiseQuality
+{
+    FULL,
+    REDUCED,
+    APPROXIMATE
+};
+
+// One FillGrid2D call to run on a ThreadPool. outDx/outDz are optional, set both to get FillGrid2DDeriv instead.
+struct TileRequest
+{
+    float originX = 0.f;
+    float originZ = 0.f;
+    float step = 1.f;
+    size_t width = 0;
+    size_t height = 0;
+    size_t octaves = 0;
+    NoiseQuality quality = NoiseQuality::FULL;
+    float* out = nullptr;
+    float* outDx = nullptr;
+    float* outDz = nullptr;
+};
+
+struct SimplexCell2D
+{
+    int32_t i = 0, j = 0;
+    int gi0 = 0, gi2 = 0;
+    int gi1[2] = {};
+    bool valid = false;
+};
+
+class Noise;
+
+template<int Octaves>
+struct FractalNoiseT
+{
+    static_assert(Octaves > 0, "FractalNoiseT needs at least one octave");
+
+    std::array<float, Octaves> frequencies = {};
+    std::array<float, Octaves> amplitudes = {};
+
+    // Running sum of the amplitudes, so any prefix of the table evaluates a smaller octave count exactly.
+    std::array<float, Octaves> denoms = {};
+
+    constexpr FractalNoiseT(float frequency, float amplitude, float lacunarity, float persistence)
+    {
+        float denom = 0.f;
+
+        for (int i = 0; i < Octaves; i++)
+        {
+            denom += amplitude;
+
+            frequencies[i] = frequency;
+            amplitudes[i] = amplitude;
+            denoms[i] = denom;
+
+            frequency *= lacunarity;
+            amplitude *= persistence;
+        }
+    }
+
+    template<int Count = Octaves>
+    float Evaluate(const Noise& noise, float x) const;
+
+    template<int Count = Octaves>
+    float Evaluate(const Noise& noise, float x, float y) const;
+
+    template<int Count = Octaves>
+    NoiseSample EvaluateDeriv(const Noise& noise, float x, float y) const;
+
+    template<int Count = Octaves>
+    float Evaluate(const Noise& noise, float x, float y, float z) const;
+};
+
 class Noise 
 {
 
 public:
     
-    static float SimplexNoise(float x)
+    float SimplexNoise(float x) const
     {
         float n0, n1;
 
@@ -77,20 +193,18 @@ public:
         float t0 = 1.0f - x0 * x0;
         
         t0 *= t0;
-        n0 = t0 * t0 * Gradient(Hash(i0), x0);
+        n0 = t0 * t0 * Gradient(mPermutation[i0 & 255], x0);
 
         float t1 = 1.0f - x1 * x1;
         
         t1 *= t1;
-        n1 = t1 * t1 * Gradient(Hash(i1), x1);
+        n1 = t1 * t1 * Gradient(mPermutation[i1 & 255], x1);
 
         return 0.395f * (n0 + n1);
     }
 
-    static float SimplexNoise(float x, float y)
+    float SimplexNoise(float x, float y) const
     {
-        float n0, n1, n2;
-
         static const float F2 = 0.366025403f;
         static const float G2 = 0.211324865f;
 
@@ -119,49 +233,93 @@ public:
             j1 = 1;
         }
 
-        const float x1 = x0 - i1 + G2;
-        const float y1 = y0 - j1 + G2;
-        const float x2 = x0 - 1.0f + 2.0f * G2;
-        const float y2 = y0 - 1.0f + 2.0f * G2;
+        const int32_t ii = i & 255;
+        const int32_t jj = j & 255;
 
-        const int gi0 = Hash(i + Hash(j));
-        const int gi1 = Hash(i + i1 + Hash(j + j1));
-        const int gi2 = Hash(i + 1 + Hash(j + 1));
+        const int gi0 = mPermutation[ii + mPermutation[jj]];
+        const int gi1 = mPermutation[ii + i1 + mPermutation[jj + j1]];
+        const int gi2 = mPermutation[ii + 1 + mPermutation[jj + 1]];
 
-        float t0 = 0.5f - x0 * x0 - y0 * y0;
+        return SimplexCorners(x0, y0, i1, j1, gi0, gi1, gi2);
+    }
 
-        if (t0 < 0.0f) 
-            n0 = 0.0f;
-        else 
-        {
-            t0 *= t0;
-            n0 = t0 * t0 * Gradient(gi0, x0, y0);
-        }
+    float SimplexNoise(float x, float y, SimplexCell2D& cell) const
+    {
+        static const float F2 = 0.366025403f;
+        static const float G2 = 0.211324865f;
 
-        float t1 = 0.5f - x1 * x1 - y1 * y1;
+        const float s = (x + y) * F2;
+        const float xs = x + s;
+        const float ys = y + s;
+        const int32_t i = FastFloor(xs);
+        const int32_t j = FastFloor(ys);
 
-        if (t1 < 0.0f) 
-            n1 = 0.0f;
-        else 
+        const float t = static_cast<float>(i + j) * G2;
+        const float X0 = i - t;
+        const float Y0 = j - t;
+        const float x0 = x - X0;
+        const float y0 = y - Y0;
+
+        if (!cell.valid || cell.i != i || cell.j != j)
         {
-            t1 *= t1;
-            n1 = t1 * t1 * Gradient(gi1, x1, y1);
+            const int32_t ii = i & 255;
+            const int32_t jj = j & 255;
+
+            cell.i = i;
+            cell.j = j;
+            cell.gi0 = mPermutation[ii + mPermutation[jj]];
+            cell.gi1[0] = mPermutation[ii + 1 + mPermutation[jj]];
+            cell.gi1[1] = mPermutation[ii + mPermutation[jj + 1]];
+            cell.gi2 = mPermutation[ii + 1 + mPermutation[jj + 1]];
+            cell.valid = true;
         }
 
-        float t2 = 0.5f - x2 * x2 - y2 * y2;
+        if (x0 > y0)
+            return SimplexCorners(x0, y0, 1, 0, cell.gi0, cell.gi1[0], cell.gi2);
+        else
+            return SimplexCorners(x0, y0, 0, 1, cell.gi0, cell.gi1[1], cell.gi2);
+    }
 
-        if (t2 < 0.0f) 
-            n2 = 0.0f;
-        else 
-        {
-            t2 *= t2;
-            n2 = t2 * t2 * Gradient(gi2, x2, y2);
-        }
+    NoiseSample SimplexNoiseDeriv(float x, float y) const
+    {
+        static const float F2 = 0.366025403f;
+        static const float G2 = 0.211324865f;
 
-        return 45.23065f * (n0 + n1 + n2);
+        const float s = (x + y) * F2;
+        const int32_t i = FastFloor(x + s);
+        const int32_t j = FastFloor(y + s);
+
+        const float t = static_cast<float>(i + j) * G2;
+        const float x0 = x - (i - t);
+        const float y0 = y - (j - t);
+
+        const int32_t i1 = x0 > y0 ? 1 : 0;
+        const int32_t j1 = x0 > y0 ? 0 : 1;
+
+        const float x1 = x0 - i1 + G2;
+        const float y1 = y0 - j1 + G2;
+        const float x2 = x0 - 1.0f + 2.0f * G2;
+        const float y2 = y0 - 1.0f + 2.0f * G2;
+
+        const int32_t ii = i & 255;
+        const int32_t jj = j & 255;
+
+        float n0, n1, n2, dx0, dx1, dx2, dy0, dy1, dy2;
+
+        SimplexCornerDeriv(x0, y0, mPermutation[ii + mPermutation[jj]], n0, dx0, dy0);
+        SimplexCornerDeriv(x1, y1, mPermutation[ii + i1 + mPermutation[jj + j1]], n1, dx1, dy1);
+        SimplexCornerDeriv(x2, y2, mPermutation[ii + 1 + mPermutation[jj + 1]], n2, dx2, dy2);
+
+        NoiseSample out = {};
+
+        out.value = 45.23065f * (n0 + n1 + n2);
+        out.dx = 45.23065f * (dx0 + dx1 + dx2);
+        out.dy = 45.23065f * (dy0 + dy1 + dy2);
+
+        return out;
     }
 
-    static float SimplexNoise(float x, float y, float z)
+    float SimplexNoise(float x, float y, float z) const
     {
         float n0, n1, n2, n3;
 
@@ -254,10 +412,14 @@ public:
         float y3 = y0 - 1.0f + 3.0f * G3;
         float z3 = z0 - 1.0f + 3.0f * G3;
 
-        int gi0 = Hash(i + Hash(j + Hash(k)));
-        int gi1 = Hash(i + i1 + Hash(j + j1 + Hash(k + k1)));
-        int gi2 = Hash(i + i2 + Hash(j + j2 + Hash(k + k2)));
-        int gi3 = Hash(i + 1 + Hash(j + 1 + Hash(k + 1)));
+        int ii = i & 255;
+        int jj = j & 255;
+        int kk = k & 255;
+
+        int gi0 = mPermutation[ii + mPermutation[jj + mPermutation[kk]]];
+        int gi1 = mPermutation[ii + i1 + mPermutation[jj + j1 + mPermutation[kk + k1]]];
+        int gi2 = mPermutation[ii + i2 + mPermutation[jj + j2 + mPermutation[kk + k2]]];
+        int gi3 = mPermutation[ii + 1 + mPermutation[jj + 1 + mPermutation[kk + 1]]];
 
         float t0 = 0.6f - x0 * x0 - y0 * y0 - z0 * z0;
 
@@ -304,6 +466,9 @@ public:
 
     float FractalNoise(size_t octaves, float x) const
     {
+        if (octaves >= 1 && octaves <= FRACTAL_MAX_OCTAVES)
+            return DispatchOctaves<float>(octaves, [&](auto count) { return mFractal.template Evaluate<decltype(count)::value>(*this, x); });
+
         float output = 0.f;
         float denom = 0.f;
         float frequency = mFrequency;
@@ -323,6 +488,9 @@ public:
 
     float FractalNoise(size_t octaves, float x, float y) const
     {
+        if (octaves >= 1 && octaves <= FRACTAL_MAX_OCTAVES)
+            return DispatchOctaves<float>(octaves, [&](auto count) { return mFractal.template Evaluate<decltype(count)::value>(*this, x, y); });
+
         float output = 0.f;
         float denom = 0.f;
         float frequency = mFrequency;
@@ -340,8 +508,42 @@ public:
         return (output / denom);
     }
 
+    NoiseSample FractalNoiseDeriv(size_t octaves, float x, float y) const
+    {
+        if (octaves >= 1 && octaves <= FRACTAL_MAX_OCTAVES)
+            return DispatchOctaves<NoiseSample>(octaves, [&](auto count) { return mFractal.template EvaluateDeriv<decltype(count)::value>(*this, x, y); });
+
+        NoiseSample output = {};
+        float denom = 0.f;
+        float frequency = mFrequency;
+        float amplitude = mAmplitude;
+
+        for (size_t i = 0; i < octaves; i++) 
+        {
+            const NoiseSample sample = SimplexNoiseDeriv(x * frequency, y * frequency);
+            const float weight = amplitude * frequency;
+
+            output.value += (amplitude * sample.value);
+            output.dx += (weight * sample.dx);
+            output.dy += (weight * sample.dy);
+            denom += amplitude;
+
+            frequency *= mLacunarity;
+            amplitude *= mPersistence;
+        }
+
+        output.value = (output.value / denom);
+        output.dx = (output.dx / denom);
+        output.dy = (output.dy / denom);
+
+        return output;
+    }
+
     float FractalNoise(size_t octaves, float x, float y, float z) const
     {
+        if (octaves >= 1 && octaves <= FRACTAL_MAX_OCTAVES)
+            return DispatchOctaves<float>(octaves, [&](auto count) { return mFractal.template Evaluate<decltype(count)::value>(*this, x, y, z); });
+
         float output = 0.f;
         float denom = 0.f;
         float frequency = mFrequency;
@@ -359,17 +561,694 @@ public:
         return (output / denom);
     }
 
-    explicit Noise(float frequency = 1.0f, float amplitude = 1.0f, float lacunarity = 2.0f, float persistence = 0.5f) : mFrequency(frequency), mAmplitude(amplitude), mLacunarity(lacunarity), mPersistence(persistence) 
+    void FractalNoise2D(size_t octaves, const float* xs, const float* zs, float* out, size_t count) const
+    {
+        size_t index = NoiseSIMD::FractalNoise2D(GetFractalParameters(octaves), xs, zs, out, count);
+
+        for (; index < count; index++)
+            out[index] = FractalNoise(octaves, xs[index], zs[index]);
+    }
+
+    void FractalNoise3D(size_t octaves, const float* xs, const float* ys, const float* zs, float* out, size_t count) const
+    {
+        size_t index = NoiseSIMD::FractalNoise3D(GetFractalParameters(octaves), xs, ys, zs, out, count);
+
+        for (; index < count; index++)
+            out[index] = FractalNoise(octaves, xs[index], ys[index], zs[index]);
+    }
+
+    void FillGrid2D(float originX, float originZ, float step, size_t width, size_t height, size_t octaves, float* out, NoiseQuality quality = NoiseQuality::FULL) const
+    {
+        if (quality == NoiseQuality::APPROXIMATE)
+            FillGridApproximate(originX, originZ, step, width, height, octaves, out, nullptr, nullptr);
+        else
+        {
+            const size_t evaluated = quality == NoiseQuality::REDUCED ? GetReducedOctaves(octaves, step) : octaves;
+
+            FillGridRows(BuildGridTables(originX, step, width, evaluated, octaves), originZ, step, width, 0, height, evaluated, out);
+        }
+    }
+
+    void FillGrid2DDeriv(float originX, float originZ, float step, size_t width, size_t height, size_t octaves, float* out, float* outDx, float* outDz, NoiseQuality quality = NoiseQuality::FULL) const
+    {
+        if (quality == NoiseQuality::APPROXIMATE)
+            FillGridApproximate(originX, originZ, step, width, height, octaves, out, outDx, outDz);
+        else
+        {
+            const size_t evaluated = quality == NoiseQuality::REDUCED ? GetReducedOctaves(octaves, step) : octaves;
+
+            FillGridRowsDeriv(BuildGridTables(originX, step, width, evaluated, octaves), originZ, step, width, 0, height, evaluated, out, outDx, outDz);
+        }
+    }
+
+    // Number of octaves at or below the Nyquist limit of a grid with the given step, zero when even the first is above it.
+    size_t GetReducedOctaves(size_t octaves, float step) const
+    {
+        return GetOctavesBelow(octaves, step, 0.5f);
+    }
+
+    // Number of octaves bilinear interpolation on a lattice with the given spacing reproduces within NOISE_SIMPLEX_2D_BOUND,
+    // past those dropping an octave costs less than interpolating it.
+    size_t GetApproximateOctaves(size_t octaves, float lattice) const
+    {
+        return GetOctavesBelow(octaves, lattice, 2.0f * std::sqrt(NOISE_SIMPLEX_2D_BOUND / NOISE_SIMPLEX_2D_CURVATURE_BOUND));
+    }
+
+    // Upper bound on |FillGrid2D(quality) - FillGrid2D(FULL)| for the same grid.
+    float GetQualityError(NoiseQuality quality, size_t octaves, float step) const
+    {
+        if (quality == NoiseQuality::FULL || octaves == 0)
+            return 0.f;
+
+        const float lattice = step * NOISE_APPROXIMATE_STRIDE;
+        const size_t evaluated = quality == NoiseQuality::APPROXIMATE ? GetApproximateOctaves(octaves, lattice) : GetReducedOctaves(octaves, step);
+
+        float frequency = mFrequency;
+        float amplitude = mAmplitude;
+        float denom = 0.f;
+        float out = 0.f;
+
+        for (size_t octave = 0; octave < octaves; octave++)
+        {
+            denom += amplitude;
+
+            // Bilinear interpolation over a square cell of side h is off by at most h^2 / 8 times the sum of the bounds on
+            // the second partial derivatives, which scale with the frequency squared. A dropped octave is off by its bound.
+            if (octave >= evaluated)
+                out += amplitude * NOISE_SIMPLEX_2D_BOUND;
+            else if (quality == NoiseQuality::APPROXIMATE)
+                out += amplitude * NOISE_SIMPLEX_2D_CURVATURE_BOUND * frequency * frequency * lattice * lattice * 0.25f;
+
+            frequency *= mLacunarity;
+            amplitude *= mPersistence;
+        }
+
+        return out / denom;
+    }
+
+    // Cheapest tier whose error bound fits in maxError.
+    NoiseQuality SelectQuality(size_t octaves, float step, float maxError) const
+    {
+        if (GetQualityError(NoiseQuality::APPROXIMATE, octaves, step) <= maxError)
+            return NoiseQuality::APPROXIMATE;
+
+        if (GetQualityError(NoiseQuality::REDUCED, octaves, step) <= maxError)
+            return NoiseQuality::REDUCED;
+
+        return NoiseQuality::FULL;
+    }
+
+    // Splits the tiles into bands of rows and fills them on the pool, at each request's quality. Every row is computed
+    // exactly as FillGrid2D/FillGrid2DDeriv would, so the output does not depend on the thread count. APPROXIMATE tiles
+    // interpolate one lattice across all their rows and go out as a single band.
+    void GenerateTiles(const TileRequest* requests, size_t count, ThreadPool& pool) const
+    {
+        struct TileJob
+        {
+            const TileRequest* request;
+            size_t firstRow;
+            size_t lastRow;
+        };
+
+        std::vector<TileJob> jobs;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const size_t band = requests[i].quality == NoiseQuality::APPROXIMATE ? std::max<size_t>(requests[i].height, 1) : NOISE_TILE_BAND_ROWS;
+
+            for (size_t row = 0; row < requests[i].height; row += band)
+                jobs.push_back({ &requests[i], row, std::min(row + band, requests[i].height) });
+        }
+
+        pool.ParallelFor(jobs.size(), [&](size_t index)
+        {
+            const TileJob& job = jobs[index];
+            const TileRequest& request = *job.request;
+
+            if (request.quality == NoiseQuality::APPROXIMATE)
+            {
+                const bool deriv = request.outDx && request.outDz;
+
+                FillGridApproximate(request.originX, request.originZ, request.step, request.width, request.height, request.octaves, request.out, deriv ? request.outDx : nullptr, deriv ? request.outDz : nullptr);
+                return;
+            }
+
+            const size_t evaluated = request.quality == NoiseQuality::REDUCED ? GetReducedOctaves(request.octaves, request.step) : request.octaves;
+            const GridTables tables = BuildGridTables(request.originX, request.step, request.width, evaluated, request.octaves);
+
+            if (request.outDx && request.outDz)
+                FillGridRowsDeriv(tables, request.originZ, request.step, request.width, job.firstRow, job.lastRow, evaluated, request.out, request.outDx, request.outDz);
+            else
+                FillGridRows(tables, request.originZ, request.step, request.width, job.firstRow, job.lastRow, evaluated, request.out);
+        });
+    }
+
+    void GenerateTiles(std::vector<TileRequest>& requests, ThreadPool& pool) const
+    {
+        GenerateTiles(requests.data(), requests.size(), pool);
+    }
+
+    CellularSample CellularNoise(float x, float y, float frequency, float jitter = 1.0f) const
+    {
+        x *= frequency;
+        y *= frequency;
+
+        const int32_t i = FastFloor(x);
+        const int32_t j = FastFloor(y);
+        const float fx = x - static_cast<float>(i);
+        const float fy = y - static_cast<float>(j);
+
+        float f1 = 3.402823466e+38f;
+        float f2 = f1;
+        CellularSample out = {};
+
+        for (int32_t dj = -1; dj <= 1; dj++)
+        {
+            const int32_t row = mPermutation[(j + dj) & 255];
+
+            for (int32_t di = -1; di <= 1; di++)
+            {
+                const int32_t h = mPermutation[((i + di) & 255) + row];
+                const float offsetX = (static_cast<float>(mPermutation[h]) * (1.0f / 255.0f) - 0.5f) * jitter;
+                const float offsetY = (static_cast<float>(mPermutation[h + 1]) * (1.0f / 255.0f) - 0.5f) * jitter;
+                const float px = (static_cast<float>(di) + 0.5f + offsetX) - fx;
+                const float py = (static_cast<float>(dj) + 0.5f + offsetY) - fy;
+                const float d = px * px + py * py;
+
+                if (d < f1)
+                {
+                    f2 = f1;
+                    out.id2 = out.id1;
+                    f1 = d;
+                    out.id1 = h;
+                }
+                else if (d < f2)
+                {
+                    f2 = d;
+                    out.id2 = h;
+                }
+            }
+        }
+
+        out.f1 = std::sqrt(f1);
+        out.f2 = std::sqrt(f2);
+
+        return out;
+    }
+
+    void CellularNoise2D(float frequency, float jitter, const float* xs, const float* zs, float* outF1, float* outF2, int32_t* outId1, int32_t* outId2, size_t count) const
+    {
+        size_t index = NoiseSIMD::CellularNoise2D(GetCellularParameters(frequency, jitter), xs, zs, outF1, outF2, outId1, outId2, count);
+
+        for (; index < count; index++)
+        {
+            const CellularSample sample = CellularNoise(xs[index], zs[index], frequency, jitter);
+
+            outF1[index] = sample.f1;
+            outF2[index] = sample.f2;
+            outId1[index] = sample.id1;
+            outId2[index] = sample.id2;
+        }
+    }
+
+    void FillCellularGrid2D(float originX, float originZ, float step, size_t width, size_t height, float frequency, float jitter, float* outF1, float* outF2, int32_t* outId1, int32_t* outId2) const
+    {
+        std::vector<float> xs(width);
+        std::vector<float> zs(width);
+
+        for (size_t x = 0; x < width; x++)
+            xs[x] = originX + static_cast<float>(x) * step;
+
+        for (size_t z = 0; z < height; z++)
+        {
+            const size_t row = z * width;
+
+            std::fill(zs.begin(), zs.end(), originZ + static_cast<float>(z) * step);
+
+            CellularNoise2D(frequency, jitter, xs.data(), zs.data(), outF1 + row, outF2 + row, outId1 + row, outId2 + row, width);
+        }
+    }
+
+    CellularParameters GetCellularParameters(float frequency, float jitter) const
+    {
+        CellularParameters out = {};
+
+        out.permutation = mPermutation;
+        out.frequency = frequency;
+        out.jitter = jitter;
+
+        return out;
+    }
+
+    FractalParameters GetFractalParameters(size_t octaves) const
+    {
+        FractalParameters out = {};
+
+        out.permutation = mPermutation;
+        out.octaves = octaves;
+        out.frequency = mFrequency;
+        out.amplitude = mAmplitude;
+        out.lacunarity = mLacunarity;
+        out.persistence = mPersistence;
+
+        return out;
+    }
+
+    explicit Noise(float frequency = 1.0f, float amplitude = 1.0f, float lacunarity = 2.0f, float persistence = 0.5f, uint32_t seed = 0) : mFrequency(frequency), mAmplitude(amplitude), mLacunarity(lacunarity), mPersistence(persistence), mFractal(frequency, amplitude, lacunarity, persistence) 
+    {
+        SetSeed(seed);
+    }
+
+    // Seed 0 keeps the reference permutation, any other seed shuffles it. Fixed cost, no allocation.
+    void SetSeed(uint32_t seed)
+    {
+        mSeed = seed;
+
+        for (int32_t i = 0; i < 256; i++)
+            mPermutation[i] = perm[i];
+
+        if (seed != 0)
+        {
+            uint64_t state = seed;
+
+            for (int32_t i = 255; i > 0; i--)
+            {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+
+                const int32_t j = static_cast<int32_t>(((state >> 32) * static_cast<uint64_t>(i + 1)) >> 32);
+                const int32_t swap = mPermutation[i];
+
+                mPermutation[i] = mPermutation[j];
+                mPermutation[j] = swap;
+            }
+        }
+
+        for (int32_t i = 0; i < 256; i++)
+            mPermutation[i + 256] = mPermutation[i];
+    }
+
+    uint32_t GetSeed() const
+    {
+        return mSeed;
+    }
+
+    const int32_t* GetPermutationTable() const
     {
+        return mPermutation;
+    }
 
+    const FractalNoiseT<FRACTAL_MAX_OCTAVES>& GetFractalTables() const
+    {
+        return mFractal;
     }
 
 private:
+
+    // octaves has to be in 1 .. FRACTAL_MAX_OCTAVES, it indexes a table with one instantiation of function per count.
+    template<typename Result, typename Function>
+    static Result DispatchOctaves(size_t octaves, Function&& function)
+    {
+        return DispatchOctaves<Result>(octaves, function, std::make_integer_sequence<int, FRACTAL_MAX_OCTAVES>{});
+    }
+
+    template<typename Result, typename Function, int... Counts>
+    static Result DispatchOctaves(size_t octaves, Function& function, std::integer_sequence<int, Counts...>)
+    {
+        static constexpr Result (*table[])(Function&) = { [](Function& function) -> Result { return function(std::integral_constant<int, Counts + 1>{}); }... };
+
+        return table[octaves - 1](function);
+    }
+
+    // Number of leading octaves whose frequency times spacing stays within limit, possibly zero.
+    size_t GetOctavesBelow(size_t octaves, float spacing, float limit) const
+    {
+        size_t out = 0;
+        float frequency = mFrequency;
+
+        while (out < octaves && frequency * spacing <= limit)
+        {
+            frequency *= mLacunarity;
+            out++;
+        }
+
+        return out;
+    }
+
+    struct GridTables
+    {
+        std::vector<float> frequencies;
+        std::vector<float> amplitudes;
+        std::vector<float> weights;
+        std::vector<float> columns;
+        float denom = 0.f;
+    };
+
+    // Tables for the first octaves, normalized as if normalization octaves (at least octaves) were summed.
+    GridTables BuildGridTables(float originX, float step, size_t width, size_t octaves, size_t normalization = 0) const
+    {
+        GridTables out = {};
+        float frequency = mFrequency;
+        float amplitude = mAmplitude;
+
+        out.frequencies.resize(octaves);
+        out.amplitudes.resize(octaves);
+        out.weights.resize(octaves);
+        out.columns.resize(octaves * width);
+
+        for (size_t octave = 0; octave < std::max(octaves, normalization); octave++)
+        {
+            out.denom += amplitude;
+
+            if (octave < octaves)
+            {
+                out.frequencies[octave] = frequency;
+                out.amplitudes[octave] = amplitude;
+                out.weights[octave] = amplitude * frequency;
+
+                for (size_t x = 0; x < width; x++)
+                    out.columns[octave * width + x] = (originX + static_cast<float>(x) * step) * frequency;
+            }
+
+            frequency *= mLacunarity;
+            amplitude *= mPersistence;
+        }
+
+        return out;
+    }
+
+    GridRowParameters GetGridRowParameters(const GridTables& tables, size_t width, size_t octaves, const float* rows) const
+    {
+        GridRowParameters out = {};
+
+        out.permutation = mPermutation;
+        out.octaves = octaves;
+        out.stride = width;
+        out.columns = tables.columns.data();
+        out.rows = rows;
+        out.amplitudes = tables.amplitudes.data();
+        out.weights = tables.weights.data();
+        out.denom = tables.denom;
+
+        return out;
+    }
+
+    // The SIMD kernel keeps every octave of a block of columns in registers, the scalar path finishes the columns it left.
+    void FillGridRows(const GridTables& tables, float originZ, float step, size_t width, size_t firstRow, size_t lastRow, size_t octaves, float* out) const
+    {
+        std::vector<float> rows(octaves);
+        const GridRowParameters parameters = GetGridRowParameters(tables, width, octaves, rows.data());
+
+        for (size_t z = firstRow; z < lastRow; z++)
+        {
+            float* row = out + z * width;
+            const float rowZ = originZ + static_cast<float>(z) * step;
+
+            for (size_t octave = 0; octave < octaves; octave++)
+                rows[octave] = rowZ * tables.frequencies[octave];
+
+            const size_t written = NoiseSIMD::FillRow2D(parameters, row, width);
+
+            for (size_t x = written; x < width; x++)
+                row[x] = 0.f;
+
+            for (size_t octave = 0; octave < octaves && written < width; octave++)
+            {
+                const float* xs = tables.columns.data() + octave * width;
+                const float amplitude = tables.amplitudes[octave];
+                SimplexCell2D cell;
+
+                for (size_t x = written; x < width; x++)
+                    row[x] += (amplitude * SimplexNoise(xs[x], rows[octave], cell));
+            }
+
+            for (size_t x = written; x < width; x++)
+                row[x] = (row[x] / tables.denom);
+        }
+    }
+
+    void FillGridRowsDeriv(const GridTables& tables, float originZ, float step, size_t width, size_t firstRow, size_t lastRow, size_t octaves, float* out, float* outDx, float* outDz) const
+    {
+        std::vector<float> rows(octaves);
+        const GridRowParameters parameters = GetGridRowParameters(tables, width, octaves, rows.data());
+
+        for (size_t z = firstRow; z < lastRow; z++)
+        {
+            float* row = out + z * width;
+            float* rowDx = outDx + z * width;
+            float* rowDz = outDz + z * width;
+            const float rowZ = originZ + static_cast<float>(z) * step;
+
+            for (size_t octave = 0; octave < octaves; octave++)
+                rows[octave] = rowZ * tables.frequencies[octave];
+
+            const size_t written = NoiseSIMD::FillRow2DDeriv(parameters, row, rowDx, rowDz, width);
+
+            for (size_t x = written; x < width; x++)
+                row[x] = rowDx[x] = rowDz[x] = 0.f;
+
+            for (size_t octave = 0; octave < octaves && written < width; octave++)
+            {
+                const float* xs = tables.columns.data() + octave * width;
+                const float amplitude = tables.amplitudes[octave];
+                const float weight = tables.weights[octave];
+
+                for (size_t x = written; x < width; x++)
+                {
+                    const NoiseSample sample = SimplexNoiseDeriv(xs[x], rows[octave]);
+
+                    row[x] += (amplitude * sample.value);
+                    rowDx[x] += (weight * sample.dx);
+                    rowDz[x] += (weight * sample.dy);
+                }
+            }
+
+            for (size_t x = written; x < width; x++)
+            {
+                row[x] = (row[x] / tables.denom);
+                rowDx[x] = (rowDx[x] / tables.denom);
+                rowDz[x] = (rowDz[x] / tables.denom);
+            }
+        }
+    }
+
+    void FillGridApproximate(float originX, float originZ, float step, size_t width, size_t height, size_t octaves, float* out, float* outDx, float* outDz) const
+    {
+        const float lattice = step * NOISE_APPROXIMATE_STRIDE;
+        const size_t evaluated = GetApproximateOctaves(octaves, lattice);
+
+        if (evaluated == 0)
+        {
+            std::fill(out, out + width * height, 0.f);
+
+            if (outDx && outDz)
+            {
+                std::fill(outDx, outDx + width * height, 0.f);
+                std::fill(outDz, outDz + width * height, 0.f);
+            }
+
+            return;
+        }
+
+        // Aligning the lattice to world space keeps shared tile edges identical.
+        const float firstX = std::floor(originX / lattice) * lattice;
+        const float firstZ = std::floor(originZ / lattice) * lattice;
+        const size_t columns = static_cast<size_t>(std::ceil((originX + static_cast<float>(width - 1) * step - firstX) / lattice)) + 2;
+        const size_t rows = static_cast<size_t>(std::ceil((originZ + static_cast<float>(height - 1) * step - firstZ) / lattice)) + 2;
+
+        std::vector<float> values(columns * rows), dx, dz;
+        const GridTables tables = BuildGridTables(firstX, lattice, columns, evaluated, octaves);
+
+        if (outDx && outDz)
+        {
+            dx.resize(values.size());
+            dz.resize(values.size());
+            FillGridRowsDeriv(tables, firstZ, lattice, columns, 0, rows, evaluated, values.data(), dx.data(), dz.data());
+        }
+        else
+            FillGridRows(tables, firstZ, lattice, columns, 0, rows, evaluated, values.data());
+
+        std::vector<size_t> cellX(width);
+        std::vector<float> weightX(width);
+
+        for (size_t x = 0; x < width; x++)
+        {
+            const float fx = (originX + static_cast<float>(x) * step - firstX) / lattice;
+
+            cellX[x] = std::min(static_cast<size_t>(fx), columns - 2);
+            weightX[x] = fx - static_cast<float>(cellX[x]);
+        }
+
+        auto Interpolate = [&](const float* source, size_t x, size_t top, float tz)
+        {
+            const float* corner = source + top * columns + cellX[x];
+            const float upper = corner[0] + (corner[1] - corner[0]) * weightX[x];
+            const float lower = corner[columns] + (corner[columns + 1] - corner[columns]) * weightX[x];
+
+            return upper + (lower - upper) * tz;
+        };
+
+        for (size_t z = 0; z < height; z++)
+        {
+            const float fz = (originZ + static_cast<float>(z) * step - firstZ) / lattice;
+            const size_t top = std::min(static_cast<size_t>(fz), rows - 2);
+            const float tz = fz - static_cast<float>(top);
+
+            for (size_t x = 0; x < width; x++)
+            {
+                out[z * width + x] = Interpolate(values.data(), x, top, tz);
+
+                if (outDx && outDz)
+                {
+                    outDx[z * width + x] = Interpolate(dx.data(), x, top, tz);
+                    outDz[z * width + x] = Interpolate(dz.data(), x, top, tz);
+                }
+            }
+        }
+    }
+
+    static inline void SimplexCornerDeriv(float x, float y, int hash, float& n, float& dx, float& dy)
+    {
+        const float t = 0.5f - x * x - y * y;
+
+        if (t < 0.0f)
+        {
+            n = dx = dy = 0.0f;
+            return;
+        }
+
+        float gx, gy;
+        GradientCoefficients(hash, gx, gy);
+
+        const float t2 = t * t;
+        const float t4 = t2 * t2;
+        const float gradient = Gradient(hash, x, y);
+        const float falloff = -8.0f * t2 * t * gradient;
+
+        n = t4 * gradient;
+        dx = falloff * x + t4 * gx;
+        dy = falloff * y + t4 * gy;
+    }
+
+    static inline float SimplexCorners(float x0, float y0, int32_t i1, int32_t j1, int gi0, int gi1, int gi2)
+    {
+        static const float G2 = 0.211324865f;
+
+        float n0, n1, n2;
+
+        const float x1 = x0 - i1 + G2;
+        const float y1 = y0 - j1 + G2;
+        const float x2 = x0 - 1.0f + 2.0f * G2;
+        const float y2 = y0 - 1.0f + 2.0f * G2;
+
+        float t0 = 0.5f - x0 * x0 - y0 * y0;
+
+        if (t0 < 0.0f) 
+            n0 = 0.0f;
+        else 
+        {
+            t0 *= t0;
+            n0 = t0 * t0 * Gradient(gi0, x0, y0);
+        }
+
+        float t1 = 0.5f - x1 * x1 - y1 * y1;
+
+        if (t1 < 0.0f) 
+            n1 = 0.0f;
+        else 
+        {
+            t1 *= t1;
+            n1 = t1 * t1 * Gradient(gi1, x1, y1);
+        }
+
+        float t2 = 0.5f - x2 * x2 - y2 * y2;
+
+        if (t2 < 0.0f) 
+            n2 = 0.0f;
+        else 
+        {
+            t2 *= t2;
+            n2 = t2 * t2 * Gradient(gi2, x2, y2);
+        }
+
+        return 45.23065f * (n0 + n1 + n2);
+    }
     
     float mFrequency;
     float mAmplitude;
     float mLacunarity;
     float mPersistence;
+
+    FractalNoiseT<FRACTAL_MAX_OCTAVES> mFractal;
+
+    uint32_t mSeed = 0;
+    int32_t mPermutation[512] = {};
 };
 
+template<int Octaves>
+template<int Count>
+float FractalNoiseT<Octaves>::Evaluate(const Noise& noise, float x) const
+{
+    static_assert(Count > 0 && Count <= Octaves, "Octave count exceeds the table");
+
+    float output = 0.f;
+
+    for (int i = 0; i < Count; i++)
+        output += (amplitudes[i] * noise.SimplexNoise(x * frequencies[i]));
+
+    return (output / denoms[Count - 1]);
+}
+
+template<int Octaves>
+template<int Count>
+float FractalNoiseT<Octaves>::Evaluate(const Noise& noise, float x, float y) const
+{
+    static_assert(Count > 0 && Count <= Octaves, "Octave count exceeds the table");
+
+    float output = 0.f;
+
+    for (int i = 0; i < Count; i++)
+        output += (amplitudes[i] * noise.SimplexNoise(x * frequencies[i], y * frequencies[i]));
+
+    return (output / denoms[Count - 1]);
+}
+
+template<int Octaves>
+template<int Count>
+NoiseSample FractalNoiseT<Octaves>::EvaluateDeriv(const Noise& noise, float x, float y) const
+{
+    static_assert(Count > 0 && Count <= Octaves, "Octave count exceeds the table");
+
+    NoiseSample output = {};
+
+    for (int i = 0; i < Count; i++)
+    {
+        const NoiseSample sample = noise.SimplexNoiseDeriv(x * frequencies[i], y * frequencies[i]);
+        const float weight = amplitudes[i] * frequencies[i];
+
+        output.value += (amplitudes[i] * sample.value);
+        output.dx += (weight * sample.dx);
+        output.dy += (weight * sample.dy);
+    }
+
+    output.value = (output.value / denoms[Count - 1]);
+    output.dx = (output.dx / denoms[Count - 1]);
+    output.dy = (output.dy / denoms[Count - 1]);
+
+    return output;
+}
+
+template<int Octaves>
+template<int Count>
+float FractalNoiseT<Octaves>::Evaluate(const Noise& noise, float x, float y, float z) const
+{
+    static_assert(Count > 0 && Count <= Octaves, "Octave count exceeds the table");
+
+    float output = 0.f;
+
+    for (int i = 0; i < Count; i++)
+        output += (amplitudes[i] * noise.SimplexNoise(x * frequencies[i], y * frequencies[i], z * frequencies[i]));
+
+    return (output / denoms[Count - 1]);
+}
+
 #endif // !NOISE_HPP
\ No newline at end of file
@@ -0,0 +1,709 @@
+#ifndef NOISE_GRAPH_HPP
+#define NOISE_GRAPH_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "math/Noise.hpp"
+
+#define NOISE_PROGRAM_LANES 16
+
+enum class NoiseNodeType
+{
+    CONSTANT,
+    FRACTAL,
+    RIDGED,
+    DOMAIN_WARP,
+    ADD,
+    MULTIPLY,
+    CLAMP,
+    CURVE,
+    SELECT
+};
+
+enum class NoiseOpcode
+{
+    FRACTAL,
+    RIDGED,
+    WARP,
+    ADD,
+    MULTIPLY,
+    CLAMP,
+    CURVE,
+    SELECT
+};
+
+struct NoiseNode
+{
+    NoiseNodeType type = NoiseNodeType::CONSTANT;
+    int inputs[3] = { -1, -1, -1 };
+    float parameters[4] = {};
+    size_t octaves = 0;
+
+    // Interleaved (input, output) control points, sorted by input.
+    std::vector<float> curve = {};
+};
+
+struct NoiseInstruction
+{
+    NoiseOpcode opcode = NoiseOpcode::ADD;
+    int output = 0;
+    int inputs[3] = {};
+    float parameters[4] = {};
+    size_t octaves = 0;
+    size_t curveOffset = 0;
+    size_t curveCount = 0;
+};
+
+class NoiseProgram
+{
+
+public:
+
+    void Evaluate(const float* xs, const float* zs, float* out, size_t count) const
+    {
+        std::vector<float> registers(static_cast<size_t>(registerCount) * NOISE_PROGRAM_LANES);
+
+        for (const auto& constant : constants)
+            std::fill_n(registers.data() + constant.first * NOISE_PROGRAM_LANES, NOISE_PROGRAM_LANES, constant.second);
+
+        float* x = registers.data();
+        float* z = registers.data() + NOISE_PROGRAM_LANES;
+
+        for (size_t start = 0; start < count; start += NOISE_PROGRAM_LANES)
+        {
+            const size_t lanes = std::min<size_t>(NOISE_PROGRAM_LANES, count - start);
+
+            for (size_t lane = 0; lane < NOISE_PROGRAM_LANES; lane++)
+            {
+                const size_t index = start + std::min(lane, lanes - 1);
+
+                x[lane] = xs[index];
+                z[lane] = zs[index];
+            }
+
+            Execute(registers.data());
+
+            std::copy_n(registers.data() + output * NOISE_PROGRAM_LANES, lanes, out + start);
+        }
+    }
+
+    void FillGrid2D(float originX, float originZ, float step, size_t width, size_t height, float* out) const
+    {
+        std::vector<float> xs(width * height);
+        std::vector<float> zs(width * height);
+
+        for (size_t z = 0; z < height; z++)
+        {
+            for (size_t x = 0; x < width; x++)
+            {
+                xs[z * width + x] = originX + static_cast<float>(x) * step;
+                zs[z * width + x] = originZ + static_cast<float>(z) * step;
+            }
+        }
+
+        Evaluate(xs.data(), zs.data(), out, width * height);
+    }
+
+    size_t GetInstructionCount() const
+    {
+        return instructions.size();
+    }
+
+private:
+
+    friend class NoiseGraph;
+
+    void Execute(float* registers) const
+    {
+        for (const NoiseInstruction& instruction : instructions)
+        {
+            float* out = registers + instruction.output * NOISE_PROGRAM_LANES;
+            const float* a = registers + instruction.inputs[0] * NOISE_PROGRAM_LANES;
+            const float* b = registers + instruction.inputs[1] * NOISE_PROGRAM_LANES;
+            const float* c = registers + instruction.inputs[2] * NOISE_PROGRAM_LANES;
+            const float* p = instruction.parameters;
+
+            switch (instruction.opcode)
+            {
+
+            case NoiseOpcode::FRACTAL:
+            case NoiseOpcode::RIDGED:
+            {
+                FractalParameters fractal = {};
+
+                fractal.permutation = noise.GetPermutationTable();
+                fractal.octaves = instruction.octaves;
+                fractal.frequency = p[0];
+                fractal.amplitude = p[1];
+                fractal.lacunarity = p[2];
+                fractal.persistence = p[3];
+
+                const bool ridged = instruction.opcode == NoiseOpcode::RIDGED;
+                size_t lane = ridged ? NoiseSIMD::RidgedNoise2D(fractal, a, b, out, NOISE_PROGRAM_LANES) : NoiseSIMD::FractalNoise2D(fractal, a, b, out, NOISE_PROGRAM_LANES);
+
+                for (; lane < NOISE_PROGRAM_LANES; lane++)
+                    out[lane] = FractalNoise(fractal, ridged, a[lane], b[lane]);
+
+                break;
+            }
+
+            case NoiseOpcode::WARP:
+                for (size_t lane = 0; lane < NOISE_PROGRAM_LANES; lane++)
+                    out[lane] = a[lane] + p[0] * b[lane];
+                break;
+
+            case NoiseOpcode::ADD:
+                for (size_t lane = 0; lane < NOISE_PROGRAM_LANES; lane++)
+                    out[lane] = a[lane] + b[lane];
+                break;
+
+            case NoiseOpcode::MULTIPLY:
+                for (size_t lane = 0; lane < NOISE_PROGRAM_LANES; lane++)
+                    out[lane] = a[lane] * b[lane];
+                break;
+
+            case NoiseOpcode::CLAMP:
+                for (size_t lane = 0; lane < NOISE_PROGRAM_LANES; lane++)
+                    out[lane] = std::min(std::max(a[lane], p[0]), p[1]);
+                break;
+
+            case NoiseOpcode::CURVE:
+            {
+                const float* points = curves.data() + instruction.curveOffset;
+                const size_t last = (instruction.curveCount - 1) * 2;
+
+                for (size_t lane = 0; lane < NOISE_PROGRAM_LANES; lane++)
+                {
+                    const float value = a[lane];
+
+                    if (value <= points[0])
+                        out[lane] = points[1];
+                    else if (value >= points[last])
+                        out[lane] = points[last + 1];
+                    else
+                    {
+                        size_t segment = 2;
+
+                        while (points[segment] < value)
+                            segment += 2;
+
+                        const float t = (value - points[segment - 2]) / (points[segment] - points[segment - 2]);
+
+                        out[lane] = points[segment - 1] + (points[segment + 1] - points[segment - 1]) * t;
+                    }
+                }
+
+                break;
+            }
+
+            case NoiseOpcode::SELECT:
+                for (size_t lane = 0; lane < NOISE_PROGRAM_LANES; lane++)
+                {
+                    float t = c[lane] > p[0] ? 1.0f : 0.0f;
+
+                    if (p[1] > 0.0f)
+                    {
+                        t = std::min(std::max((c[lane] - p[0] + p[1]) / (2.0f * p[1]), 0.0f), 1.0f);
+                        t = t * t * (3.0f - 2.0f * t);
+                    }
+
+                    out[lane] = a[lane] + (b[lane] - a[lane]) * t;
+                }
+                break;
+            }
+        }
+    }
+
+    float FractalNoise(const FractalParameters& fractal, bool ridged, float x, float z) const
+    {
+        float output = 0.f;
+        float denom = 0.f;
+        float frequency = fractal.frequency;
+        float amplitude = fractal.amplitude;
+
+        for (size_t i = 0; i < fractal.octaves; i++)
+        {
+            float value = noise.SimplexNoise(x * frequency, z * frequency);
+
+            if (ridged)
+            {
+                value = 1.0f - std::fabs(value);
+                value = value * value;
+            }
+
+            output += (amplitude * value);
+            denom += amplitude;
+
+            frequency *= fractal.lacunarity;
+            amplitude *= fractal.persistence;
+        }
+
+        return (output / denom);
+    }
+
+    std::vector<NoiseInstruction> instructions = {};
+    std::vector<std::pair<int, float>> constants = {};
+    std::vector<float> curves = {};
+    Noise noise = Noise();
+    int registerCount = 2;
+    int output = 0;
+};
+
+/*
+ * Text form, one node per line, '#' starts a comment. Operands are node names or numbers:
+ *
+ *   base   = fractal 24 0.45 10 2 0.5      # octaves frequency [amplitude lacunarity persistence]
+ *   ridges = ridged 6 0.1
+ *   warpX  = fractal 4 0.05
+ *   warpZ  = fractal 4 0.05 1 2 0.5
+ *   warped = warp ridges warpX warpZ 8     # source offsetX offsetZ strength
+ *   mask   = curve base -0.2 0 0.2 1       # input output pairs
+ *   shape  = select base warped mask 0.5 0.1
+ *   height = mul shape 4
+ *   output height
+ *
+ * Also available: constant, add, clamp (value min max). Octave counts are whole numbers from 1 to FRACTAL_MAX_OCTAVES.
+ * World::InitalizeWorld loads the terrain from WORLD_TERRAIN_GRAPH when that file exists.
+ */
+class NoiseGraph
+{
+
+public:
+
+    int Constant(float value)
+    {
+        NoiseNode node = {};
+
+        node.type = NoiseNodeType::CONSTANT;
+        node.parameters[0] = value;
+
+        return AddNode(node);
+    }
+
+    int Fractal(size_t octaves, float frequency, float amplitude = 1.0f, float lacunarity = 2.0f, float persistence = 0.5f)
+    {
+        return AddFractal(NoiseNodeType::FRACTAL, octaves, frequency, amplitude, lacunarity, persistence);
+    }
+
+    int Ridged(size_t octaves, float frequency, float amplitude = 1.0f, float lacunarity = 2.0f, float persistence = 0.5f)
+    {
+        return AddFractal(NoiseNodeType::RIDGED, octaves, frequency, amplitude, lacunarity, persistence);
+    }
+
+    int DomainWarp(int source, int offsetX, int offsetZ, float strength)
+    {
+        NoiseNode node = {};
+
+        node.type = NoiseNodeType::DOMAIN_WARP;
+        node.inputs[0] = source;
+        node.inputs[1] = offsetX;
+        node.inputs[2] = offsetZ;
+        node.parameters[0] = strength;
+
+        return AddNode(node);
+    }
+
+    int Add(int a, int b)
+    {
+        return AddBinary(NoiseNodeType::ADD, a, b);
+    }
+
+    int Multiply(int a, int b)
+    {
+        return AddBinary(NoiseNodeType::MULTIPLY, a, b);
+    }
+
+    int Clamp(int value, float min, float max)
+    {
+        NoiseNode node = {};
+
+        node.type = NoiseNodeType::CLAMP;
+        node.inputs[0] = value;
+        node.parameters[0] = min;
+        node.parameters[1] = max;
+
+        return AddNode(node);
+    }
+
+    // points are (input, output) pairs in any order. Returns -1 for fewer than two pairs, which Compile treats as a
+    // missing node.
+    int Curve(int value, const std::vector<float>& points)
+    {
+        if (points.size() < 4)
+            return -1;
+
+        NoiseNode node = {};
+
+        node.type = NoiseNodeType::CURVE;
+        node.inputs[0] = value;
+        node.curve = points;
+
+        std::vector<std::pair<float, float>> sorted;
+
+        for (size_t i = 0; i + 1 < points.size(); i += 2)
+            sorted.push_back({ points[i], points[i + 1] });
+
+        std::sort(sorted.begin(), sorted.end());
+        node.curve.clear();
+
+        for (const auto& point : sorted)
+        {
+            node.curve.push_back(point.first);
+            node.curve.push_back(point.second);
+        }
+
+        return AddNode(node);
+    }
+
+    int Select(int a, int b, int mask, float threshold, float falloff = 0.0f)
+    {
+        NoiseNode node = {};
+
+        node.type = NoiseNodeType::SELECT;
+        node.inputs[0] = a;
+        node.inputs[1] = b;
+        node.inputs[2] = mask;
+        node.parameters[0] = threshold;
+        node.parameters[1] = falloff;
+
+        return AddNode(node);
+    }
+
+    void SetOutput(int node)
+    {
+        output = node;
+    }
+
+    // The program keeps its own copy of the Noise (and so its seed), so it may outlive the instance it was compiled against.
+    NoiseProgram Compile(const Noise& noise) const
+    {
+        NoiseProgram out = {};
+        std::map<std::tuple<int, int, int>, int> cache;
+
+        out.noise = noise;
+
+        if (output < 0 || output >= static_cast<int>(nodes.size()))
+        {
+            out.constants.push_back({ out.registerCount, 0.0f });
+            out.output = out.registerCount++;
+
+            return out;
+        }
+
+        out.output = CompileNode(out, output, 0, 1, cache);
+
+        return out;
+    }
+
+    static bool Parse(const std::string& source, NoiseGraph& out, std::string& error)
+    {
+        std::unordered_map<std::string, int> names;
+        std::istringstream lines(source);
+        std::string line;
+        int lineNumber = 0;
+
+        out = {};
+
+        while (std::getline(lines, line))
+        {
+            lineNumber++;
+
+            const size_t comment = line.find('#');
+
+            if (comment != std::string::npos)
+                line.erase(comment);
+
+            std::istringstream tokenStream(line);
+            std::vector<std::string> tokens;
+            std::string token;
+
+            while (tokenStream >> token)
+                tokens.push_back(token);
+
+            if (tokens.empty())
+                continue;
+
+            const std::string where = "line " + std::to_string(lineNumber) + ": ";
+
+            if (tokens[0] == "output")
+            {
+                if (tokens.size() != 2 || names.find(tokens[1]) == names.end())
+                {
+                    error = where + "expected 'output <node>'";
+                    return false;
+                }
+
+                out.SetOutput(names[tokens[1]]);
+                continue;
+            }
+
+            if (tokens.size() < 3 || tokens[1] != "=")
+            {
+                error = where + "expected '<name> = <operation> ...'";
+                return false;
+            }
+
+            const std::string& operation = tokens[2];
+            const std::vector<std::string> arguments(tokens.begin() + 3, tokens.end());
+            std::vector<float> numbers;
+            int node = -1;
+
+            auto Number = [&](size_t index, float fallback) -> float
+            {
+                if (index >= arguments.size())
+                    return fallback;
+
+                float value;
+
+                if (!ParseNumber(arguments[index], value))
+                {
+                    error = where + "'" + arguments[index] + "' is not a number";
+                    return fallback;
+                }
+
+                return value;
+            };
+
+            auto Operand = [&](size_t index) -> int
+            {
+                if (index >= arguments.size())
+                {
+                    error = where + operation + " is missing operands";
+                    return -1;
+                }
+
+                auto iterator = names.find(arguments[index]);
+
+                if (iterator != names.end())
+                    return iterator->second;
+
+                float value;
+
+                if (ParseNumber(arguments[index], value))
+                    return out.Constant(value);
+
+                error = where + "unknown node '" + arguments[index] + "'";
+                return -1;
+            };
+
+            if (operation == "constant")
+                node = out.Constant(Number(0, 0.0f));
+            else if (operation == "fractal" || operation == "ridged")
+            {
+                const float count = Number(0, 0.0f);
+                const size_t octaves = count >= 1.0f && count <= FRACTAL_MAX_OCTAVES && count == std::floor(count) ? static_cast<size_t>(count) : 0;
+
+                if (octaves == 0)
+                    error = where + operation + " needs a whole octave count from 1 to " + std::to_string(FRACTAL_MAX_OCTAVES);
+                else if (operation == "fractal")
+                    node = out.Fractal(octaves, Number(1, 1.0f), Number(2, 1.0f), Number(3, 2.0f), Number(4, 0.5f));
+                else
+                    node = out.Ridged(octaves, Number(1, 1.0f), Number(2, 1.0f), Number(3, 2.0f), Number(4, 0.5f));
+            }
+            else if (operation == "warp")
+                node = out.DomainWarp(Operand(0), Operand(1), Operand(2), Number(3, 1.0f));
+            else if (operation == "add")
+                node = out.Add(Operand(0), Operand(1));
+            else if (operation == "mul")
+                node = out.Multiply(Operand(0), Operand(1));
+            else if (operation == "clamp")
+                node = out.Clamp(Operand(0), Number(1, -1.0f), Number(2, 1.0f));
+            else if (operation == "curve")
+            {
+                for (size_t i = 1; i < arguments.size(); i++)
+                    numbers.push_back(Number(i, 0.0f));
+
+                if (numbers.size() < 4 || numbers.size() % 2 != 0)
+                    error = where + "curve needs at least two input/output pairs";
+                else
+                    node = out.Curve(Operand(0), numbers);
+            }
+            else if (operation == "select")
+                node = out.Select(Operand(0), Operand(1), Operand(2), Number(3, 0.0f), Number(4, 0.0f));
+            else
+                error = where + "unknown operation '" + operation + "'";
+
+            if (!error.empty())
+                return false;
+
+            names[tokens[0]] = node;
+            out.SetOutput(node);
+        }
+
+        if (out.nodes.empty())
+        {
+            error = "graph has no nodes";
+            return false;
+        }
+
+        return true;
+    }
+
+    const std::vector<NoiseNode>& GetNodes() const
+    {
+        return nodes;
+    }
+
+private:
+
+    int AddNode(const NoiseNode& node)
+    {
+        nodes.push_back(node);
+
+        return static_cast<int>(nodes.size()) - 1;
+    }
+
+    int AddFractal(NoiseNodeType type, size_t octaves, float frequency, float amplitude, float lacunarity, float persistence)
+    {
+        assert(octaves >= 1 && octaves <= FRACTAL_MAX_OCTAVES);
+
+        NoiseNode node = {};
+
+        node.type = type;
+        node.octaves = octaves;
+        node.parameters[0] = frequency;
+        node.parameters[1] = amplitude;
+        node.parameters[2] = lacunarity;
+        node.parameters[3] = persistence;
+
+        return AddNode(node);
+    }
+
+    int AddBinary(NoiseNodeType type, int a, int b)
+    {
+        NoiseNode node = {};
+
+        node.type = type;
+        node.inputs[0] = a;
+        node.inputs[1] = b;
+
+        return AddNode(node);
+    }
+
+    static bool ParseNumber(const std::string& text, float& value)
+    {
+        char* end = nullptr;
+        value = std::strtof(text.c_str(), &end);
+
+        return end != text.c_str() && *end == '\0';
+    }
+
+    // Nodes are compiled once per coordinate pair, so a subgraph shared under the same warp is evaluated once. An input has
+    // to be a node added before the one reading it, anything else (and a curve with fewer than two points) compiles to
+    // zero like a graph without an output, which also keeps a hand built cycle from recursing forever.
+    int CompileNode(NoiseProgram& program, int index, int x, int z, std::map<std::tuple<int, int, int>, int>& cache) const
+    {
+        const auto key = std::make_tuple(index, x, z);
+        auto iterator = cache.find(key);
+
+        if (iterator != cache.end())
+            return iterator->second;
+
+        int result;
+
+        if (index < 0 || index >= static_cast<int>(nodes.size()) || (nodes[index].type == NoiseNodeType::CURVE && nodes[index].curve.size() < 4))
+        {
+            result = program.registerCount++;
+            program.constants.push_back({ result, 0.0f });
+
+            cache[key] = result;
+            return result;
+        }
+
+        const NoiseNode& node = nodes[index];
+        NoiseInstruction instruction = {};
+
+        auto Input = [&](int slot, int inputX, int inputZ) { return CompileNode(program, node.inputs[slot] < index ? node.inputs[slot] : -1, inputX, inputZ, cache); };
+
+        std::copy_n(node.parameters, 4, instruction.parameters);
+
+        switch (node.type)
+        {
+
+        case NoiseNodeType::CONSTANT:
+            result = program.registerCount++;
+            program.constants.push_back({ result, node.parameters[0] });
+
+            cache[key] = result;
+            return result;
+
+        case NoiseNodeType::DOMAIN_WARP:
+        {
+            const int offsetX = Input(1, x, z);
+            const int offsetZ = Input(2, x, z);
+
+            instruction.opcode = NoiseOpcode::WARP;
+            instruction.inputs[0] = x;
+            instruction.inputs[1] = offsetX;
+            instruction.output = program.registerCount++;
+            program.instructions.push_back(instruction);
+
+            const int warpedX = instruction.output;
+
+            instruction.inputs[0] = z;
+            instruction.inputs[1] = offsetZ;
+            instruction.output = program.registerCount++;
+            program.instructions.push_back(instruction);
+
+            result = Input(0, warpedX, instruction.output);
+
+            cache[key] = result;
+            return result;
+        }
+
+        case NoiseNodeType::FRACTAL:
+        case NoiseNodeType::RIDGED:
+            instruction.opcode = node.type == NoiseNodeType::FRACTAL ? NoiseOpcode::FRACTAL : NoiseOpcode::RIDGED;
+            instruction.octaves = node.octaves;
+            instruction.inputs[0] = x;
+            instruction.inputs[1] = z;
+            break;
+
+        case NoiseNodeType::ADD:
+        case NoiseNodeType::MULTIPLY:
+            instruction.opcode = node.type == NoiseNodeType::ADD ? NoiseOpcode::ADD : NoiseOpcode::MULTIPLY;
+            instruction.inputs[0] = Input(0, x, z);
+            instruction.inputs[1] = Input(1, x, z);
+            break;
+
+        case NoiseNodeType::CLAMP:
+            instruction.opcode = NoiseOpcode::CLAMP;
+            instruction.inputs[0] = Input(0, x, z);
+            break;
+
+        case NoiseNodeType::CURVE:
+            instruction.opcode = NoiseOpcode::CURVE;
+            instruction.inputs[0] = Input(0, x, z);
+            instruction.curveOffset = program.curves.size();
+            instruction.curveCount = node.curve.size() / 2;
+            program.curves.insert(program.curves.end(), node.curve.begin(), node.curve.end());
+            break;
+
+        case NoiseNodeType::SELECT:
+            instruction.opcode = NoiseOpcode::SELECT;
+            instruction.inputs[0] = Input(0, x, z);
+            instruction.inputs[1] = Input(1, x, z);
+            instruction.inputs[2] = Input(2, x, z);
+            break;
+        }
+
+        instruction.output = program.registerCount++;
+        program.instructions.push_back(instruction);
+
+        cache[key] = instruction.output;
+        return instruction.output;
+    }
+
+    std::vector<NoiseNode> nodes = {};
+    int output = -1;
+};
+
+#endif // !NOISE_GRAPH_HPP
\ No newline at end of file
@@ -0,0 +1,1150 @@
+#ifndef NOISE_SIMD_HPP
+#define NOISE_SIMD_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define NOISE_SIMD_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NOISE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NOISE_TARGET_AVX2
+#endif
+
+enum class NoiseInstructionSet
+{
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// Every kernel in here mirrors the scalar Noise code operation for operation (no FMA, same
+// evaluation order), so the batch paths are bit-identical to calling FractalNoise per point.
+// The permutation table is the doubled 512-entry form, which removes the masking in the hash chain.
+struct FractalParameters
+{
+    const int32_t* permutation = nullptr;
+    size_t octaves = 0;
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    float lacunarity = 2.0f;
+    float persistence = 0.5f;
+};
+
+// One row of a lattice grid. columns holds x * frequency for every octave, stride floats apart, rows holds z * frequency.
+// The sums are divided by denom, which may cover more octaves than are evaluated.
+struct GridRowParameters
+{
+    const int32_t* permutation = nullptr;
+    size_t octaves = 0;
+    size_t stride = 0;
+    const float* columns = nullptr;
+    const float* rows = nullptr;
+    const float* amplitudes = nullptr;
+    const float* weights = nullptr;
+    float denom = 1.0f;
+};
+
+struct CellularParameters
+{
+    const int32_t* permutation = nullptr;
+    float frequency = 1.0f;
+    float jitter = 1.0f;
+};
+
+namespace NoiseSIMD
+{
+    static NoiseInstructionSet DetectInstructionSet()
+    {
+#if defined(NOISE_SIMD_X86) && defined(_MSC_VER)
+        int info[4] = {};
+        __cpuid(info, 0);
+
+        if (info[0] >= 7)
+        {
+            __cpuid(info, 1);
+
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+
+            if (osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+            {
+                __cpuidex(info, 7, 0);
+
+                if ((info[1] & (1 << 5)) != 0)
+                    return NoiseInstructionSet::AVX2;
+            }
+        }
+
+        return NoiseInstructionSet::SSE2;
+#elif defined(NOISE_SIMD_X86)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return NoiseInstructionSet::AVX2;
+
+        return NoiseInstructionSet::SSE2;
+#else
+        return NoiseInstructionSet::SCALAR;
+#endif
+    }
+
+    inline NoiseInstructionSet& ActiveInstructionSet()
+    {
+        static NoiseInstructionSet instructionSet = DetectInstructionSet();
+
+        return instructionSet;
+    }
+
+    inline const char* InstructionSet2String(NoiseInstructionSet instructionSet)
+    {
+        switch (instructionSet)
+        {
+        case NoiseInstructionSet::SSE2:
+            return "SSE2";
+
+        case NoiseInstructionSet::AVX2:
+            return "AVX2";
+
+        default:
+            return "SCALAR";
+        }
+    }
+
+#ifdef NOISE_SIMD_X86
+
+    static inline __m128i FastFloor4(__m128 fp)
+    {
+        const __m128i i = _mm_cvttps_epi32(fp);
+        const __m128 below = _mm_cmplt_ps(fp, _mm_cvtepi32_ps(i));
+
+        return _mm_add_epi32(i, _mm_castps_si128(below));
+    }
+
+    static inline __m128i Gather4(const int32_t* table, __m128i indices)
+    {
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), indices);
+
+        return _mm_setr_epi32(table[lanes[0]], table[lanes[1]], table[lanes[2]], table[lanes[3]]);
+    }
+
+    static inline __m128 Select4(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    static inline __m128 Gradient4(__m128i hash, __m128 x, __m128 y)
+    {
+        const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(0x3F));
+        const __m128 low = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(0x3C)), _mm_setzero_si128()));
+
+        const __m128 u = Select4(low, x, y);
+        const __m128 v = _mm_mul_ps(_mm_set1_ps(2.0f), Select4(low, y, x));
+
+        const __m128 signU = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+        const __m128 signV = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+
+        return _mm_add_ps(_mm_xor_ps(u, signU), _mm_xor_ps(v, signV));
+    }
+
+    static inline __m128 Gradient4(__m128i hash, __m128 x, __m128 y, __m128 z)
+    {
+        const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+        const __m128 below8 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+        const __m128 below4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+        const __m128 twelveOrFourteen = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(13)), _mm_set1_epi32(12)));
+
+        const __m128 u = Select4(below8, x, y);
+        const __m128 v = Select4(below4, y, Select4(twelveOrFourteen, x, z));
+
+        const __m128 signU = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+        const __m128 signV = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+
+        return _mm_add_ps(_mm_xor_ps(u, signU), _mm_xor_ps(v, signV));
+    }
+
+    static inline __m128 Contribution4(__m128 t, __m128 gradient)
+    {
+        const __m128 negative = _mm_cmplt_ps(t, _mm_setzero_ps());
+
+        t = _mm_mul_ps(t, t);
+
+        return _mm_andnot_ps(negative, _mm_mul_ps(_mm_mul_ps(t, t), gradient));
+    }
+
+    struct SimplexCorners4
+    {
+        __m128 x0, y0, x1, y1, x2, y2;
+        __m128i gi0, gi1, gi2;
+    };
+
+    // coherent is for grid rows, where neighbouring lanes mostly land in the same cell on the low octaves: when all four
+    // share it the corner hashes are looked up once instead of gathered per lane. The hashes are the same either way.
+    static inline SimplexCorners4 SetupSimplex4(const int32_t* perm, __m128 x, __m128 y, bool coherent = false)
+    {
+        static const float F2 = 0.366025403f;
+        static const float G2 = 0.211324865f;
+
+        SimplexCorners4 out;
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 g2 = _mm_set1_ps(G2);
+
+        const __m128 s = _mm_mul_ps(_mm_add_ps(x, y), _mm_set1_ps(F2));
+        const __m128i i = FastFloor4(_mm_add_ps(x, s));
+        const __m128i j = FastFloor4(_mm_add_ps(y, s));
+
+        const __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), g2);
+        out.x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+        out.y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+        const __m128 xGreater = _mm_cmpgt_ps(out.x0, out.y0);
+        const __m128i i1 = _mm_and_si128(_mm_castps_si128(xGreater), _mm_set1_epi32(1));
+        const __m128i j1 = _mm_andnot_si128(_mm_castps_si128(xGreater), _mm_set1_epi32(1));
+
+        out.x1 = _mm_add_ps(_mm_sub_ps(out.x0, _mm_cvtepi32_ps(i1)), g2);
+        out.y1 = _mm_add_ps(_mm_sub_ps(out.y0, _mm_cvtepi32_ps(j1)), g2);
+        out.x2 = _mm_add_ps(_mm_sub_ps(out.x0, one), _mm_set1_ps(2.0f * G2));
+        out.y2 = _mm_add_ps(_mm_sub_ps(out.y0, one), _mm_set1_ps(2.0f * G2));
+
+        const __m128i mask = _mm_set1_epi32(255);
+        const __m128i ii = _mm_and_si128(i, mask);
+        const __m128i jj = _mm_and_si128(j, mask);
+        const __m128i unit = _mm_set1_epi32(1);
+
+        if (coherent)
+        {
+            const int32_t cellI = _mm_cvtsi128_si32(ii);
+            const int32_t cellJ = _mm_cvtsi128_si32(jj);
+            const __m128i same = _mm_and_si128(_mm_cmpeq_epi32(ii, _mm_set1_epi32(cellI)), _mm_cmpeq_epi32(jj, _mm_set1_epi32(cellJ)));
+
+            if (_mm_movemask_epi8(same) == 0xFFFF)
+            {
+                const __m128i lower = _mm_set1_epi32(perm[cellI + perm[cellJ + 1]]);
+                const __m128i upper = _mm_set1_epi32(perm[cellI + 1 + perm[cellJ]]);
+
+                out.gi0 = _mm_set1_epi32(perm[cellI + perm[cellJ]]);
+                out.gi1 = _mm_or_si128(_mm_and_si128(_mm_castps_si128(xGreater), upper), _mm_andnot_si128(_mm_castps_si128(xGreater), lower));
+                out.gi2 = _mm_set1_epi32(perm[cellI + 1 + perm[cellJ + 1]]);
+
+                return out;
+            }
+        }
+
+        out.gi0 = Gather4(perm, _mm_add_epi32(ii, Gather4(perm, jj)));
+        out.gi1 = Gather4(perm, _mm_add_epi32(_mm_add_epi32(ii, i1), Gather4(perm, _mm_add_epi32(jj, j1))));
+        out.gi2 = Gather4(perm, _mm_add_epi32(_mm_add_epi32(ii, unit), Gather4(perm, _mm_add_epi32(jj, unit))));
+
+        return out;
+    }
+
+    static inline __m128 SimplexNoise4(const int32_t* perm, __m128 x, __m128 y, bool coherent = false)
+    {
+        const SimplexCorners4 c = SetupSimplex4(perm, x, y, coherent);
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        const __m128 n0 = Contribution4(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(c.x0, c.x0)), _mm_mul_ps(c.y0, c.y0)), Gradient4(c.gi0, c.x0, c.y0));
+        const __m128 n1 = Contribution4(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(c.x1, c.x1)), _mm_mul_ps(c.y1, c.y1)), Gradient4(c.gi1, c.x1, c.y1));
+        const __m128 n2 = Contribution4(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(c.x2, c.x2)), _mm_mul_ps(c.y2, c.y2)), Gradient4(c.gi2, c.x2, c.y2));
+
+        return _mm_mul_ps(_mm_set1_ps(45.23065f), _mm_add_ps(_mm_add_ps(n0, n1), n2));
+    }
+
+    static inline void CornerDeriv4(__m128 x, __m128 y, __m128i hash, __m128& n, __m128& dx, __m128& dy)
+    {
+        const __m128 t = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.5f), _mm_mul_ps(x, x)), _mm_mul_ps(y, y));
+        const __m128 negative = _mm_cmplt_ps(t, _mm_setzero_ps());
+
+        const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(0x3F));
+        const __m128 low = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(0x3C)), _mm_setzero_si128()));
+        const __m128 u = _mm_xor_ps(_mm_set1_ps(1.0f), _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31)));
+        const __m128 v = _mm_xor_ps(_mm_set1_ps(2.0f), _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30)));
+        const __m128 gx = Select4(low, u, v);
+        const __m128 gy = Select4(low, v, u);
+
+        const __m128 t2 = _mm_mul_ps(t, t);
+        const __m128 t4 = _mm_mul_ps(t2, t2);
+        const __m128 gradient = Gradient4(hash, x, y);
+        const __m128 falloff = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(-8.0f), t2), t), gradient);
+
+        n = _mm_andnot_ps(negative, _mm_mul_ps(t4, gradient));
+        dx = _mm_andnot_ps(negative, _mm_add_ps(_mm_mul_ps(falloff, x), _mm_mul_ps(t4, gx)));
+        dy = _mm_andnot_ps(negative, _mm_add_ps(_mm_mul_ps(falloff, y), _mm_mul_ps(t4, gy)));
+    }
+
+    static inline __m128 SimplexNoiseDeriv4(const int32_t* perm, __m128 x, __m128 y, __m128& dx, __m128& dy, bool coherent = false)
+    {
+        const SimplexCorners4 c = SetupSimplex4(perm, x, y, coherent);
+        __m128 n0, n1, n2, dx0, dx1, dx2, dy0, dy1, dy2;
+
+        CornerDeriv4(c.x0, c.y0, c.gi0, n0, dx0, dy0);
+        CornerDeriv4(c.x1, c.y1, c.gi1, n1, dx1, dy1);
+        CornerDeriv4(c.x2, c.y2, c.gi2, n2, dx2, dy2);
+
+        const __m128 scale = _mm_set1_ps(45.23065f);
+
+        dx = _mm_mul_ps(scale, _mm_add_ps(_mm_add_ps(dx0, dx1), dx2));
+        dy = _mm_mul_ps(scale, _mm_add_ps(_mm_add_ps(dy0, dy1), dy2));
+
+        return _mm_mul_ps(scale, _mm_add_ps(_mm_add_ps(n0, n1), n2));
+    }
+
+    static inline __m128 SimplexNoise4(const int32_t* perm, __m128 x, __m128 y, __m128 z)
+    {
+        static const float F3 = 1.0f / 3.0f;
+        static const float G3 = 1.0f / 6.0f;
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 limit = _mm_set1_ps(0.6f);
+        const __m128 g3 = _mm_set1_ps(G3);
+
+        const __m128 s = _mm_mul_ps(_mm_add_ps(_mm_add_ps(x, y), z), _mm_set1_ps(F3));
+        const __m128i i = FastFloor4(_mm_add_ps(x, s));
+        const __m128i j = FastFloor4(_mm_add_ps(y, s));
+        const __m128i k = FastFloor4(_mm_add_ps(z, s));
+
+        const __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_add_epi32(i, j), k)), g3);
+        const __m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+        const __m128 y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+        const __m128 z0 = _mm_sub_ps(z, _mm_sub_ps(_mm_cvtepi32_ps(k), t));
+
+        const __m128i a = _mm_castps_si128(_mm_cmpge_ps(x0, y0));
+        const __m128i b = _mm_castps_si128(_mm_cmpge_ps(y0, z0));
+        const __m128i c = _mm_castps_si128(_mm_cmpge_ps(x0, z0));
+        const __m128i unit = _mm_set1_epi32(1);
+
+        const __m128i i1 = _mm_and_si128(_mm_and_si128(a, _mm_or_si128(b, c)), unit);
+        const __m128i j1 = _mm_and_si128(_mm_andnot_si128(a, b), unit);
+        const __m128i k1 = _mm_andnot_si128(_mm_or_si128(b, _mm_and_si128(a, c)), unit);
+        const __m128i i2 = _mm_and_si128(_mm_or_si128(a, _mm_and_si128(b, c)), unit);
+        const __m128i j2 = _mm_andnot_si128(_mm_andnot_si128(b, a), unit);
+        const __m128i k2 = _mm_andnot_si128(_mm_and_si128(b, _mm_or_si128(a, c)), unit);
+
+        const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_cvtepi32_ps(i1)), g3);
+        const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_cvtepi32_ps(j1)), g3);
+        const __m128 z1 = _mm_add_ps(_mm_sub_ps(z0, _mm_cvtepi32_ps(k1)), g3);
+        const __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, _mm_cvtepi32_ps(i2)), _mm_set1_ps(2.0f * G3));
+        const __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, _mm_cvtepi32_ps(j2)), _mm_set1_ps(2.0f * G3));
+        const __m128 z2 = _mm_add_ps(_mm_sub_ps(z0, _mm_cvtepi32_ps(k2)), _mm_set1_ps(2.0f * G3));
+        const __m128 x3 = _mm_add_ps(_mm_sub_ps(x0, one), _mm_set1_ps(3.0f * G3));
+        const __m128 y3 = _mm_add_ps(_mm_sub_ps(y0, one), _mm_set1_ps(3.0f * G3));
+        const __m128 z3 = _mm_add_ps(_mm_sub_ps(z0, one), _mm_set1_ps(3.0f * G3));
+
+        const __m128i mask = _mm_set1_epi32(255);
+        const __m128i ii = _mm_and_si128(i, mask);
+        const __m128i jj = _mm_and_si128(j, mask);
+        const __m128i kk = _mm_and_si128(k, mask);
+
+        const __m128i gi0 = Gather4(perm, _mm_add_epi32(ii, Gather4(perm, _mm_add_epi32(jj, Gather4(perm, kk)))));
+        const __m128i gi1 = Gather4(perm, _mm_add_epi32(_mm_add_epi32(ii, i1), Gather4(perm, _mm_add_epi32(_mm_add_epi32(jj, j1), Gather4(perm, _mm_add_epi32(kk, k1))))));
+        const __m128i gi2 = Gather4(perm, _mm_add_epi32(_mm_add_epi32(ii, i2), Gather4(perm, _mm_add_epi32(_mm_add_epi32(jj, j2), Gather4(perm, _mm_add_epi32(kk, k2))))));
+        const __m128i gi3 = Gather4(perm, _mm_add_epi32(_mm_add_epi32(ii, unit), Gather4(perm, _mm_add_epi32(_mm_add_epi32(jj, unit), Gather4(perm, _mm_add_epi32(kk, unit))))));
+
+        const __m128 n0 = Contribution4(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(limit, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0)), _mm_mul_ps(z0, z0)), Gradient4(gi0, x0, y0, z0));
+        const __m128 n1 = Contribution4(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(limit, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1)), _mm_mul_ps(z1, z1)), Gradient4(gi1, x1, y1, z1));
+        const __m128 n2 = Contribution4(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(limit, _mm_mul_ps(x2, x2)), _mm_mul_ps(y2, y2)), _mm_mul_ps(z2, z2)), Gradient4(gi2, x2, y2, z2));
+        const __m128 n3 = Contribution4(_mm_sub_ps(_mm_sub_ps(_mm_sub_ps(limit, _mm_mul_ps(x3, x3)), _mm_mul_ps(y3, y3)), _mm_mul_ps(z3, z3)), Gradient4(gi3, x3, y3, z3));
+
+        return _mm_mul_ps(_mm_set1_ps(32.0f), _mm_add_ps(_mm_add_ps(_mm_add_ps(n0, n1), n2), n3));
+    }
+
+    NOISE_TARGET_AVX2 static inline __m256i FastFloor8(__m256 fp)
+    {
+        const __m256i i = _mm256_cvttps_epi32(fp);
+        const __m256 below = _mm256_cmp_ps(fp, _mm256_cvtepi32_ps(i), _CMP_LT_OQ);
+
+        return _mm256_add_epi32(i, _mm256_castps_si256(below));
+    }
+
+    NOISE_TARGET_AVX2 static inline __m256i Gather8(const int32_t* table, __m256i indices)
+    {
+        return _mm256_i32gather_epi32(table, indices, 4);
+    }
+
+    NOISE_TARGET_AVX2 static inline __m256 Gradient8(__m256i hash, __m256 x, __m256 y)
+    {
+        const __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(0x3F));
+        const __m256 low = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0x3C)), _mm256_setzero_si256()));
+
+        const __m256 u = _mm256_blendv_ps(y, x, low);
+        const __m256 v = _mm256_mul_ps(_mm256_set1_ps(2.0f), _mm256_blendv_ps(x, y, low));
+
+        const __m256 signU = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+        const __m256 signV = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+
+        return _mm256_add_ps(_mm256_xor_ps(u, signU), _mm256_xor_ps(v, signV));
+    }
+
+    NOISE_TARGET_AVX2 static inline __m256 Gradient8(__m256i hash, __m256 x, __m256 y, __m256 z)
+    {
+        const __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+        const __m256 below8 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h));
+        const __m256 below4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+        const __m256 twelveOrFourteen = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(h, _mm256_set1_epi32(13)), _mm256_set1_epi32(12)));
+
+        const __m256 u = _mm256_blendv_ps(y, x, below8);
+        const __m256 v = _mm256_blendv_ps(_mm256_blendv_ps(z, x, twelveOrFourteen), y, below4);
+
+        const __m256 signU = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+        const __m256 signV = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+
+        return _mm256_add_ps(_mm256_xor_ps(u, signU), _mm256_xor_ps(v, signV));
+    }
+
+    NOISE_TARGET_AVX2 static inline __m256 Contribution8(__m256 t, __m256 gradient)
+    {
+        const __m256 negative = _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_LT_OQ);
+
+        t = _mm256_mul_ps(t, t);
+
+        return _mm256_andnot_ps(negative, _mm256_mul_ps(_mm256_mul_ps(t, t), gradient));
+    }
+
+    struct SimplexCorners8
+    {
+        __m256 x0, y0, x1, y1, x2, y2;
+        __m256i gi0, gi1, gi2;
+    };
+
+    // coherent is for grid rows, where neighbouring lanes mostly land in the same cell on the low octaves: when all eight
+    // share it the corner hashes are looked up once instead of gathered per lane. The hashes are the same either way.
+    NOISE_TARGET_AVX2 static inline SimplexCorners8 SetupSimplex8(const int32_t* perm, __m256 x, __m256 y, bool coherent = false)
+    {
+        static const float F2 = 0.366025403f;
+        static const float G2 = 0.211324865f;
+
+        SimplexCorners8 out;
+
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 g2 = _mm256_set1_ps(G2);
+
+        const __m256 s = _mm256_mul_ps(_mm256_add_ps(x, y), _mm256_set1_ps(F2));
+        const __m256i i = FastFloor8(_mm256_add_ps(x, s));
+        const __m256i j = FastFloor8(_mm256_add_ps(y, s));
+
+        const __m256 t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(i, j)), g2);
+        out.x0 = _mm256_sub_ps(x, _mm256_sub_ps(_mm256_cvtepi32_ps(i), t));
+        out.y0 = _mm256_sub_ps(y, _mm256_sub_ps(_mm256_cvtepi32_ps(j), t));
+
+        const __m256i xGreater = _mm256_castps_si256(_mm256_cmp_ps(out.x0, out.y0, _CMP_GT_OQ));
+        const __m256i i1 = _mm256_and_si256(xGreater, _mm256_set1_epi32(1));
+        const __m256i j1 = _mm256_andnot_si256(xGreater, _mm256_set1_epi32(1));
+
+        out.x1 = _mm256_add_ps(_mm256_sub_ps(out.x0, _mm256_cvtepi32_ps(i1)), g2);
+        out.y1 = _mm256_add_ps(_mm256_sub_ps(out.y0, _mm256_cvtepi32_ps(j1)), g2);
+        out.x2 = _mm256_add_ps(_mm256_sub_ps(out.x0, one), _mm256_set1_ps(2.0f * G2));
+        out.y2 = _mm256_add_ps(_mm256_sub_ps(out.y0, one), _mm256_set1_ps(2.0f * G2));
+
+        const __m256i mask = _mm256_set1_epi32(255);
+        const __m256i ii = _mm256_and_si256(i, mask);
+        const __m256i jj = _mm256_and_si256(j, mask);
+        const __m256i unit = _mm256_set1_epi32(1);
+
+        if (coherent)
+        {
+            const int32_t cellI = _mm_cvtsi128_si32(_mm256_castsi256_si128(ii));
+            const int32_t cellJ = _mm_cvtsi128_si32(_mm256_castsi256_si128(jj));
+            const __m256i same = _mm256_and_si256(_mm256_cmpeq_epi32(ii, _mm256_set1_epi32(cellI)), _mm256_cmpeq_epi32(jj, _mm256_set1_epi32(cellJ)));
+
+            if (_mm256_movemask_epi8(same) == -1)
+            {
+                out.gi0 = _mm256_set1_epi32(perm[cellI + perm[cellJ]]);
+                out.gi1 = _mm256_blendv_epi8(_mm256_set1_epi32(perm[cellI + perm[cellJ + 1]]), _mm256_set1_epi32(perm[cellI + 1 + perm[cellJ]]), xGreater);
+                out.gi2 = _mm256_set1_epi32(perm[cellI + 1 + perm[cellJ + 1]]);
+
+                return out;
+            }
+        }
+
+        out.gi0 = Gather8(perm, _mm256_add_epi32(ii, Gather8(perm, jj)));
+        out.gi1 = Gather8(perm, _mm256_add_epi32(_mm256_add_epi32(ii, i1), Gather8(perm, _mm256_add_epi32(jj, j1))));
+        out.gi2 = Gather8(perm, _mm256_add_epi32(_mm256_add_epi32(ii, unit), Gather8(perm, _mm256_add_epi32(jj, unit))));
+
+        return out;
+    }
+
+    NOISE_TARGET_AVX2 static inline __m256 SimplexNoise8(const int32_t* perm, __m256 x, __m256 y, bool coherent = false)
+    {
+        const SimplexCorners8 c = SetupSimplex8(perm, x, y, coherent);
+        const __m256 half = _mm256_set1_ps(0.5f);
+
+        const __m256 n0 = Contribution8(_mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(c.x0, c.x0)), _mm256_mul_ps(c.y0, c.y0)), Gradient8(c.gi0, c.x0, c.y0));
+        const __m256 n1 = Contribution8(_mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(c.x1, c.x1)), _mm256_mul_ps(c.y1, c.y1)), Gradient8(c.gi1, c.x1, c.y1));
+        const __m256 n2 = Contribution8(_mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(c.x2, c.x2)), _mm256_mul_ps(c.y2, c.y2)), Gradient8(c.gi2, c.x2, c.y2));
+
+        return _mm256_mul_ps(_mm256_set1_ps(45.23065f), _mm256_add_ps(_mm256_add_ps(n0, n1), n2));
+    }
+
+    NOISE_TARGET_AVX2 static inline void CornerDeriv8(__m256 x, __m256 y, __m256i hash, __m256& n, __m256& dx, __m256& dy)
+    {
+        const __m256 t = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(x, x)), _mm256_mul_ps(y, y));
+        const __m256 negative = _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_LT_OQ);
+
+        const __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(0x3F));
+        const __m256 low = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0x3C)), _mm256_setzero_si256()));
+        const __m256 u = _mm256_xor_ps(_mm256_set1_ps(1.0f), _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31)));
+        const __m256 v = _mm256_xor_ps(_mm256_set1_ps(2.0f), _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30)));
+        const __m256 gx = _mm256_blendv_ps(v, u, low);
+        const __m256 gy = _mm256_blendv_ps(u, v, low);
+
+        const __m256 t2 = _mm256_mul_ps(t, t);
+        const __m256 t4 = _mm256_mul_ps(t2, t2);
+        const __m256 gradient = Gradient8(hash, x, y);
+        const __m256 falloff = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(-8.0f), t2), t), gradient);
+
+        n = _mm256_andnot_ps(negative, _mm256_mul_ps(t4, gradient));
+        dx = _mm256_andnot_ps(negative, _mm256_add_ps(_mm256_mul_ps(falloff, x), _mm256_mul_ps(t4, gx)));
+        dy = _mm256_andnot_ps(negative, _mm256_add_ps(_mm256_mul_ps(falloff, y), _mm256_mul_ps(t4, gy)));
+    }
+
+    NOISE_TARGET_AVX2 static inline __m256 SimplexNoiseDeriv8(const int32_t* perm, __m256 x, __m256 y, __m256& dx, __m256& dy, bool coherent = false)
+    {
+        const SimplexCorners8 c = SetupSimplex8(perm, x, y, coherent);
+        __m256 n0, n1, n2, dx0, dx1, dx2, dy0, dy1, dy2;
+
+        CornerDeriv8(c.x0, c.y0, c.gi0, n0, dx0, dy0);
+        CornerDeriv8(c.x1, c.y1, c.gi1, n1, dx1, dy1);
+        CornerDeriv8(c.x2, c.y2, c.gi2, n2, dx2, dy2);
+
+        const __m256 scale = _mm256_set1_ps(45.23065f);
+
+        dx = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_add_ps(dx0, dx1), dx2));
+        dy = _mm256_mul_ps(scale, _mm256_add_ps(_mm256_add_ps(dy0, dy1), dy2));
+
+        return _mm256_mul_ps(scale, _mm256_add_ps(_mm256_add_ps(n0, n1), n2));
+    }
+
+    NOISE_TARGET_AVX2 static inline __m256 SimplexNoise8(const int32_t* perm, __m256 x, __m256 y, __m256 z)
+    {
+        static const float F3 = 1.0f / 3.0f;
+        static const float G3 = 1.0f / 6.0f;
+
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 limit = _mm256_set1_ps(0.6f);
+        const __m256 g3 = _mm256_set1_ps(G3);
+
+        const __m256 s = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(x, y), z), _mm256_set1_ps(F3));
+        const __m256i i = FastFloor8(_mm256_add_ps(x, s));
+        const __m256i j = FastFloor8(_mm256_add_ps(y, s));
+        const __m256i k = FastFloor8(_mm256_add_ps(z, s));
+
+        const __m256 t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_add_epi32(i, j), k)), g3);
+        const __m256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(_mm256_cvtepi32_ps(i), t));
+        const __m256 y0 = _mm256_sub_ps(y, _mm256_sub_ps(_mm256_cvtepi32_ps(j), t));
+        const __m256 z0 = _mm256_sub_ps(z, _mm256_sub_ps(_mm256_cvtepi32_ps(k), t));
+
+        const __m256i a = _mm256_castps_si256(_mm256_cmp_ps(x0, y0, _CMP_GE_OQ));
+        const __m256i b = _mm256_castps_si256(_mm256_cmp_ps(y0, z0, _CMP_GE_OQ));
+        const __m256i c = _mm256_castps_si256(_mm256_cmp_ps(x0, z0, _CMP_GE_OQ));
+        const __m256i unit = _mm256_set1_epi32(1);
+
+        const __m256i i1 = _mm256_and_si256(_mm256_and_si256(a, _mm256_or_si256(b, c)), unit);
+        const __m256i j1 = _mm256_and_si256(_mm256_andnot_si256(a, b), unit);
+        const __m256i k1 = _mm256_andnot_si256(_mm256_or_si256(b, _mm256_and_si256(a, c)), unit);
+        const __m256i i2 = _mm256_and_si256(_mm256_or_si256(a, _mm256_and_si256(b, c)), unit);
+        const __m256i j2 = _mm256_andnot_si256(_mm256_andnot_si256(b, a), unit);
+        const __m256i k2 = _mm256_andnot_si256(_mm256_and_si256(b, _mm256_or_si256(a, c)), unit);
+
+        const __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_cvtepi32_ps(i1)), g3);
+        const __m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_cvtepi32_ps(j1)), g3);
+        const __m256 z1 = _mm256_add_ps(_mm256_sub_ps(z0, _mm256_cvtepi32_ps(k1)), g3);
+        const __m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_cvtepi32_ps(i2)), _mm256_set1_ps(2.0f * G3));
+        const __m256 y2 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_cvtepi32_ps(j2)), _mm256_set1_ps(2.0f * G3));
+        const __m256 z2 = _mm256_add_ps(_mm256_sub_ps(z0, _mm256_cvtepi32_ps(k2)), _mm256_set1_ps(2.0f * G3));
+        const __m256 x3 = _mm256_add_ps(_mm256_sub_ps(x0, one), _mm256_set1_ps(3.0f * G3));
+        const __m256 y3 = _mm256_add_ps(_mm256_sub_ps(y0, one), _mm256_set1_ps(3.0f * G3));
+        const __m256 z3 = _mm256_add_ps(_mm256_sub_ps(z0, one), _mm256_set1_ps(3.0f * G3));
+
+        const __m256i mask = _mm256_set1_epi32(255);
+        const __m256i ii = _mm256_and_si256(i, mask);
+        const __m256i jj = _mm256_and_si256(j, mask);
+        const __m256i kk = _mm256_and_si256(k, mask);
+
+        const __m256i gi0 = Gather8(perm, _mm256_add_epi32(ii, Gather8(perm, _mm256_add_epi32(jj, Gather8(perm, kk)))));
+        const __m256i gi1 = Gather8(perm, _mm256_add_epi32(_mm256_add_epi32(ii, i1), Gather8(perm, _mm256_add_epi32(_mm256_add_epi32(jj, j1), Gather8(perm, _mm256_add_epi32(kk, k1))))));
+        const __m256i gi2 = Gather8(perm, _mm256_add_epi32(_mm256_add_epi32(ii, i2), Gather8(perm, _mm256_add_epi32(_mm256_add_epi32(jj, j2), Gather8(perm, _mm256_add_epi32(kk, k2))))));
+        const __m256i gi3 = Gather8(perm, _mm256_add_epi32(_mm256_add_epi32(ii, unit), Gather8(perm, _mm256_add_epi32(_mm256_add_epi32(jj, unit), Gather8(perm, _mm256_add_epi32(kk, unit))))));
+
+        const __m256 n0 = Contribution8(_mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(limit, _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0)), _mm256_mul_ps(z0, z0)), Gradient8(gi0, x0, y0, z0));
+        const __m256 n1 = Contribution8(_mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(limit, _mm256_mul_ps(x1, x1)), _mm256_mul_ps(y1, y1)), _mm256_mul_ps(z1, z1)), Gradient8(gi1, x1, y1, z1));
+        const __m256 n2 = Contribution8(_mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(limit, _mm256_mul_ps(x2, x2)), _mm256_mul_ps(y2, y2)), _mm256_mul_ps(z2, z2)), Gradient8(gi2, x2, y2, z2));
+        const __m256 n3 = Contribution8(_mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(limit, _mm256_mul_ps(x3, x3)), _mm256_mul_ps(y3, y3)), _mm256_mul_ps(z3, z3)), Gradient8(gi3, x3, y3, z3));
+
+        return _mm256_mul_ps(_mm256_set1_ps(32.0f), _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(n0, n1), n2), n3));
+    }
+
+#endif
+
+    // Returns how many points were written; the caller finishes the remainder with the scalar path.
+    static size_t FractalNoise2D_SSE2(const FractalParameters& parameters, const float* xs, const float* zs, float* out, size_t count)
+    {
+#ifdef NOISE_SIMD_X86
+        size_t index = 0;
+
+        for (; index + 4 <= count; index += 4)
+        {
+            const __m128 x = _mm_loadu_ps(xs + index);
+            const __m128 z = _mm_loadu_ps(zs + index);
+
+            __m128 output = _mm_setzero_ps();
+            float denom = 0.f;
+            float frequency = parameters.frequency;
+            float amplitude = parameters.amplitude;
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                const __m128 scale = _mm_set1_ps(frequency);
+
+                output = _mm_add_ps(output, _mm_mul_ps(_mm_set1_ps(amplitude), SimplexNoise4(parameters.permutation, _mm_mul_ps(x, scale), _mm_mul_ps(z, scale))));
+                denom += amplitude;
+
+                frequency *= parameters.lacunarity;
+                amplitude *= parameters.persistence;
+            }
+
+            _mm_storeu_ps(out + index, _mm_div_ps(output, _mm_set1_ps(denom)));
+        }
+
+        return index;
+#else
+        return 0;
+#endif
+    }
+
+    static size_t RidgedNoise2D_SSE2(const FractalParameters& parameters, const float* xs, const float* zs, float* out, size_t count)
+    {
+#ifdef NOISE_SIMD_X86
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        size_t index = 0;
+
+        for (; index + 4 <= count; index += 4)
+        {
+            const __m128 x = _mm_loadu_ps(xs + index);
+            const __m128 z = _mm_loadu_ps(zs + index);
+
+            __m128 output = _mm_setzero_ps();
+            float denom = 0.f;
+            float frequency = parameters.frequency;
+            float amplitude = parameters.amplitude;
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                const __m128 scale = _mm_set1_ps(frequency);
+                const __m128 ridge = _mm_sub_ps(one, _mm_andnot_ps(sign, SimplexNoise4(parameters.permutation, _mm_mul_ps(x, scale), _mm_mul_ps(z, scale))));
+
+                output = _mm_add_ps(output, _mm_mul_ps(_mm_set1_ps(amplitude), _mm_mul_ps(ridge, ridge)));
+                denom += amplitude;
+
+                frequency *= parameters.lacunarity;
+                amplitude *= parameters.persistence;
+            }
+
+            _mm_storeu_ps(out + index, _mm_div_ps(output, _mm_set1_ps(denom)));
+        }
+
+        return index;
+#else
+        return 0;
+#endif
+    }
+
+    static size_t CellularNoise2D_SSE2(const CellularParameters& parameters, const float* xs, const float* zs, float* outF1, float* outF2, int32_t* outId1, int32_t* outId2, size_t count)
+    {
+#ifdef NOISE_SIMD_X86
+        const int32_t* perm = parameters.permutation;
+        const __m128 frequency = _mm_set1_ps(parameters.frequency);
+        const __m128 jitter = _mm_set1_ps(parameters.jitter);
+        const __m128 inverse = _mm_set1_ps(1.0f / 255.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128i mask = _mm_set1_epi32(255);
+        size_t index = 0;
+
+        for (; index + 4 <= count; index += 4)
+        {
+            const __m128 x = _mm_mul_ps(_mm_loadu_ps(xs + index), frequency);
+            const __m128 y = _mm_mul_ps(_mm_loadu_ps(zs + index), frequency);
+            const __m128i i = FastFloor4(x);
+            const __m128i j = FastFloor4(y);
+            const __m128 fx = _mm_sub_ps(x, _mm_cvtepi32_ps(i));
+            const __m128 fy = _mm_sub_ps(y, _mm_cvtepi32_ps(j));
+
+            __m128 f1 = _mm_set1_ps(3.402823466e+38f);
+            __m128 f2 = f1;
+            __m128 id1 = _mm_setzero_ps();
+            __m128 id2 = _mm_setzero_ps();
+
+            for (int dj = -1; dj <= 1; dj++)
+            {
+                const __m128i row = Gather4(perm, _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(dj)), mask));
+
+                for (int di = -1; di <= 1; di++)
+                {
+                    const __m128i h = Gather4(perm, _mm_add_epi32(_mm_and_si128(_mm_add_epi32(i, _mm_set1_epi32(di)), mask), row));
+                    const __m128 offsetX = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(Gather4(perm, h)), inverse), half), jitter);
+                    const __m128 offsetY = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(Gather4(perm, _mm_add_epi32(h, _mm_set1_epi32(1)))), inverse), half), jitter);
+                    const __m128 px = _mm_sub_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(di) + 0.5f), offsetX), fx);
+                    const __m128 py = _mm_sub_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(dj) + 0.5f), offsetY), fy);
+                    const __m128 d = _mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py));
+
+                    const __m128 closer = _mm_cmplt_ps(d, f1);
+                    const __m128 second = _mm_cmplt_ps(d, f2);
+                    const __m128 id = _mm_castsi128_ps(h);
+
+                    f2 = Select4(closer, f1, Select4(second, d, f2));
+                    id2 = Select4(closer, id1, Select4(second, id, id2));
+                    f1 = Select4(closer, d, f1);
+                    id1 = Select4(closer, id, id1);
+                }
+            }
+
+            _mm_storeu_ps(outF1 + index, _mm_sqrt_ps(f1));
+            _mm_storeu_ps(outF2 + index, _mm_sqrt_ps(f2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(outId1 + index), _mm_castps_si128(id1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(outId2 + index), _mm_castps_si128(id2));
+        }
+
+        return index;
+#else
+        return 0;
+#endif
+    }
+
+    static size_t FractalNoise3D_SSE2(const FractalParameters& parameters, const float* xs, const float* ys, const float* zs, float* out, size_t count)
+    {
+#ifdef NOISE_SIMD_X86
+        size_t index = 0;
+
+        for (; index + 4 <= count; index += 4)
+        {
+            const __m128 x = _mm_loadu_ps(xs + index);
+            const __m128 y = _mm_loadu_ps(ys + index);
+            const __m128 z = _mm_loadu_ps(zs + index);
+
+            __m128 output = _mm_setzero_ps();
+            float denom = 0.f;
+            float frequency = parameters.frequency;
+            float amplitude = parameters.amplitude;
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                const __m128 scale = _mm_set1_ps(frequency);
+
+                output = _mm_add_ps(output, _mm_mul_ps(_mm_set1_ps(amplitude), SimplexNoise4(parameters.permutation, _mm_mul_ps(x, scale), _mm_mul_ps(y, scale), _mm_mul_ps(z, scale))));
+                denom += amplitude;
+
+                frequency *= parameters.lacunarity;
+                amplitude *= parameters.persistence;
+            }
+
+            _mm_storeu_ps(out + index, _mm_div_ps(output, _mm_set1_ps(denom)));
+        }
+
+        return index;
+#else
+        return 0;
+#endif
+    }
+
+    // One grid row over all octaves, the sums stay in registers until the row is written. Returns how many columns were
+    // written; the caller finishes the remainder with the scalar path.
+    static size_t FillRow2D_SSE2(const GridRowParameters& parameters, float* out, size_t count)
+    {
+#ifdef NOISE_SIMD_X86
+        const __m128 denom = _mm_set1_ps(parameters.denom);
+        size_t index = 0;
+
+        for (; index + 4 <= count; index += 4)
+        {
+            __m128 output = _mm_setzero_ps();
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                const __m128 x = _mm_loadu_ps(parameters.columns + octave * parameters.stride + index);
+                const __m128 noise = SimplexNoise4(parameters.permutation, x, _mm_set1_ps(parameters.rows[octave]), true);
+
+                output = _mm_add_ps(output, _mm_mul_ps(_mm_set1_ps(parameters.amplitudes[octave]), noise));
+            }
+
+            _mm_storeu_ps(out + index, _mm_div_ps(output, denom));
+        }
+
+        return index;
+#else
+        return 0;
+#endif
+    }
+
+    static size_t FillRow2DDeriv_SSE2(const GridRowParameters& parameters, float* out, float* outDx, float* outDy, size_t count)
+    {
+#ifdef NOISE_SIMD_X86
+        const __m128 denom = _mm_set1_ps(parameters.denom);
+        size_t index = 0;
+
+        for (; index + 4 <= count; index += 4)
+        {
+            __m128 output = _mm_setzero_ps();
+            __m128 outputDx = _mm_setzero_ps();
+            __m128 outputDy = _mm_setzero_ps();
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                __m128 dx, dy;
+                const __m128 x = _mm_loadu_ps(parameters.columns + octave * parameters.stride + index);
+                const __m128 noise = SimplexNoiseDeriv4(parameters.permutation, x, _mm_set1_ps(parameters.rows[octave]), dx, dy, true);
+                const __m128 slope = _mm_set1_ps(parameters.weights[octave]);
+
+                output = _mm_add_ps(output, _mm_mul_ps(_mm_set1_ps(parameters.amplitudes[octave]), noise));
+                outputDx = _mm_add_ps(outputDx, _mm_mul_ps(slope, dx));
+                outputDy = _mm_add_ps(outputDy, _mm_mul_ps(slope, dy));
+            }
+
+            _mm_storeu_ps(out + index, _mm_div_ps(output, denom));
+            _mm_storeu_ps(outDx + index, _mm_div_ps(outputDx, denom));
+            _mm_storeu_ps(outDy + index, _mm_div_ps(outputDy, denom));
+        }
+
+        return index;
+#else
+        return 0;
+#endif
+    }
+
+#ifdef NOISE_SIMD_X86
+
+    NOISE_TARGET_AVX2 static size_t FillRow2D_AVX2(const GridRowParameters& parameters, float* out, size_t count)
+    {
+        const __m256 denom = _mm256_set1_ps(parameters.denom);
+        size_t index = 0;
+
+        for (; index + 8 <= count; index += 8)
+        {
+            __m256 output = _mm256_setzero_ps();
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                const __m256 x = _mm256_loadu_ps(parameters.columns + octave * parameters.stride + index);
+                const __m256 noise = SimplexNoise8(parameters.permutation, x, _mm256_set1_ps(parameters.rows[octave]), true);
+
+                output = _mm256_add_ps(output, _mm256_mul_ps(_mm256_set1_ps(parameters.amplitudes[octave]), noise));
+            }
+
+            _mm256_storeu_ps(out + index, _mm256_div_ps(output, denom));
+        }
+
+        GridRowParameters rest = parameters;
+        rest.columns += index;
+
+        return index + FillRow2D_SSE2(rest, out + index, count - index);
+    }
+
+    NOISE_TARGET_AVX2 static size_t FillRow2DDeriv_AVX2(const GridRowParameters& parameters, float* out, float* outDx, float* outDy, size_t count)
+    {
+        const __m256 denom = _mm256_set1_ps(parameters.denom);
+        size_t index = 0;
+
+        for (; index + 8 <= count; index += 8)
+        {
+            __m256 output = _mm256_setzero_ps();
+            __m256 outputDx = _mm256_setzero_ps();
+            __m256 outputDy = _mm256_setzero_ps();
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                __m256 dx, dy;
+                const __m256 x = _mm256_loadu_ps(parameters.columns + octave * parameters.stride + index);
+                const __m256 noise = SimplexNoiseDeriv8(parameters.permutation, x, _mm256_set1_ps(parameters.rows[octave]), dx, dy, true);
+                const __m256 slope = _mm256_set1_ps(parameters.weights[octave]);
+
+                output = _mm256_add_ps(output, _mm256_mul_ps(_mm256_set1_ps(parameters.amplitudes[octave]), noise));
+                outputDx = _mm256_add_ps(outputDx, _mm256_mul_ps(slope, dx));
+                outputDy = _mm256_add_ps(outputDy, _mm256_mul_ps(slope, dy));
+            }
+
+            _mm256_storeu_ps(out + index, _mm256_div_ps(output, denom));
+            _mm256_storeu_ps(outDx + index, _mm256_div_ps(outputDx, denom));
+            _mm256_storeu_ps(outDy + index, _mm256_div_ps(outputDy, denom));
+        }
+
+        GridRowParameters rest = parameters;
+        rest.columns += index;
+
+        return index + FillRow2DDeriv_SSE2(rest, out + index, outDx + index, outDy + index, count - index);
+    }
+
+    NOISE_TARGET_AVX2 static size_t FractalNoise2D_AVX2(const FractalParameters& parameters, const float* xs, const float* zs, float* out, size_t count)
+    {
+        size_t index = 0;
+
+        for (; index + 8 <= count; index += 8)
+        {
+            const __m256 x = _mm256_loadu_ps(xs + index);
+            const __m256 z = _mm256_loadu_ps(zs + index);
+
+            __m256 output = _mm256_setzero_ps();
+            float denom = 0.f;
+            float frequency = parameters.frequency;
+            float amplitude = parameters.amplitude;
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                const __m256 scale = _mm256_set1_ps(frequency);
+
+                output = _mm256_add_ps(output, _mm256_mul_ps(_mm256_set1_ps(amplitude), SimplexNoise8(parameters.permutation, _mm256_mul_ps(x, scale), _mm256_mul_ps(z, scale))));
+                denom += amplitude;
+
+                frequency *= parameters.lacunarity;
+                amplitude *= parameters.persistence;
+            }
+
+            _mm256_storeu_ps(out + index, _mm256_div_ps(output, _mm256_set1_ps(denom)));
+        }
+
+        return index + FractalNoise2D_SSE2(parameters, xs + index, zs + index, out + index, count - index);
+    }
+
+    NOISE_TARGET_AVX2 static size_t RidgedNoise2D_AVX2(const FractalParameters& parameters, const float* xs, const float* zs, float* out, size_t count)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 sign = _mm256_set1_ps(-0.0f);
+        size_t index = 0;
+
+        for (; index + 8 <= count; index += 8)
+        {
+            const __m256 x = _mm256_loadu_ps(xs + index);
+            const __m256 z = _mm256_loadu_ps(zs + index);
+
+            __m256 output = _mm256_setzero_ps();
+            float denom = 0.f;
+            float frequency = parameters.frequency;
+            float amplitude = parameters.amplitude;
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                const __m256 scale = _mm256_set1_ps(frequency);
+                const __m256 ridge = _mm256_sub_ps(one, _mm256_andnot_ps(sign, SimplexNoise8(parameters.permutation, _mm256_mul_ps(x, scale), _mm256_mul_ps(z, scale))));
+
+                output = _mm256_add_ps(output, _mm256_mul_ps(_mm256_set1_ps(amplitude), _mm256_mul_ps(ridge, ridge)));
+                denom += amplitude;
+
+                frequency *= parameters.lacunarity;
+                amplitude *= parameters.persistence;
+            }
+
+            _mm256_storeu_ps(out + index, _mm256_div_ps(output, _mm256_set1_ps(denom)));
+        }
+
+        return index + RidgedNoise2D_SSE2(parameters, xs + index, zs + index, out + index, count - index);
+    }
+
+    NOISE_TARGET_AVX2 static size_t CellularNoise2D_AVX2(const CellularParameters& parameters, const float* xs, const float* zs, float* outF1, float* outF2, int32_t* outId1, int32_t* outId2, size_t count)
+    {
+        const int32_t* perm = parameters.permutation;
+        const __m256 frequency = _mm256_set1_ps(parameters.frequency);
+        const __m256 jitter = _mm256_set1_ps(parameters.jitter);
+        const __m256 inverse = _mm256_set1_ps(1.0f / 255.0f);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256i mask = _mm256_set1_epi32(255);
+        size_t index = 0;
+
+        for (; index + 8 <= count; index += 8)
+        {
+            const __m256 x = _mm256_mul_ps(_mm256_loadu_ps(xs + index), frequency);
+            const __m256 y = _mm256_mul_ps(_mm256_loadu_ps(zs + index), frequency);
+            const __m256i i = FastFloor8(x);
+            const __m256i j = FastFloor8(y);
+            const __m256 fx = _mm256_sub_ps(x, _mm256_cvtepi32_ps(i));
+            const __m256 fy = _mm256_sub_ps(y, _mm256_cvtepi32_ps(j));
+
+            __m256 f1 = _mm256_set1_ps(3.402823466e+38f);
+            __m256 f2 = f1;
+            __m256 id1 = _mm256_setzero_ps();
+            __m256 id2 = _mm256_setzero_ps();
+
+            for (int dj = -1; dj <= 1; dj++)
+            {
+                const __m256i row = Gather8(perm, _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(dj)), mask));
+
+                for (int di = -1; di <= 1; di++)
+                {
+                    const __m256i h = Gather8(perm, _mm256_add_epi32(_mm256_and_si256(_mm256_add_epi32(i, _mm256_set1_epi32(di)), mask), row));
+                    const __m256 offsetX = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(Gather8(perm, h)), inverse), half), jitter);
+                    const __m256 offsetY = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(Gather8(perm, _mm256_add_epi32(h, _mm256_set1_epi32(1)))), inverse), half), jitter);
+                    const __m256 px = _mm256_sub_ps(_mm256_add_ps(_mm256_set1_ps(static_cast<float>(di) + 0.5f), offsetX), fx);
+                    const __m256 py = _mm256_sub_ps(_mm256_add_ps(_mm256_set1_ps(static_cast<float>(dj) + 0.5f), offsetY), fy);
+                    const __m256 d = _mm256_add_ps(_mm256_mul_ps(px, px), _mm256_mul_ps(py, py));
+
+                    const __m256 closer = _mm256_cmp_ps(d, f1, _CMP_LT_OQ);
+                    const __m256 second = _mm256_cmp_ps(d, f2, _CMP_LT_OQ);
+                    const __m256 id = _mm256_castsi256_ps(h);
+
+                    f2 = _mm256_blendv_ps(_mm256_blendv_ps(f2, d, second), f1, closer);
+                    id2 = _mm256_blendv_ps(_mm256_blendv_ps(id2, id, second), id1, closer);
+                    f1 = _mm256_blendv_ps(f1, d, closer);
+                    id1 = _mm256_blendv_ps(id1, id, closer);
+                }
+            }
+
+            _mm256_storeu_ps(outF1 + index, _mm256_sqrt_ps(f1));
+            _mm256_storeu_ps(outF2 + index, _mm256_sqrt_ps(f2));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(outId1 + index), _mm256_castps_si256(id1));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(outId2 + index), _mm256_castps_si256(id2));
+        }
+
+        return index + CellularNoise2D_SSE2(parameters, xs + index, zs + index, outF1 + index, outF2 + index, outId1 + index, outId2 + index, count - index);
+    }
+
+    NOISE_TARGET_AVX2 static size_t FractalNoise3D_AVX2(const FractalParameters& parameters, const float* xs, const float* ys, const float* zs, float* out, size_t count)
+    {
+        size_t index = 0;
+
+        for (; index + 8 <= count; index += 8)
+        {
+            const __m256 x = _mm256_loadu_ps(xs + index);
+            const __m256 y = _mm256_loadu_ps(ys + index);
+            const __m256 z = _mm256_loadu_ps(zs + index);
+
+            __m256 output = _mm256_setzero_ps();
+            float denom = 0.f;
+            float frequency = parameters.frequency;
+            float amplitude = parameters.amplitude;
+
+            for (size_t octave = 0; octave < parameters.octaves; octave++)
+            {
+                const __m256 scale = _mm256_set1_ps(frequency);
+
+                output = _mm256_add_ps(output, _mm256_mul_ps(_mm256_set1_ps(amplitude), SimplexNoise8(parameters.permutation, _mm256_mul_ps(x, scale), _mm256_mul_ps(y, scale), _mm256_mul_ps(z, scale))));
+                denom += amplitude;
+
+                frequency *= parameters.lacunarity;
+                amplitude *= parameters.persistence;
+            }
+
+            _mm256_storeu_ps(out + index, _mm256_div_ps(output, _mm256_set1_ps(denom)));
+        }
+
+        return index + FractalNoise3D_SSE2(parameters, xs + index, ys + index, zs + index, out + index, count - index);
+    }
+
+#endif
+
+    inline size_t FractalNoise2D(const FractalParameters& parameters, const float* xs, const float* zs, float* out, size_t count)
+    {
+        switch (ActiveInstructionSet())
+        {
+
+#ifdef NOISE_SIMD_X86
+        case NoiseInstructionSet::AVX2:
+            return FractalNoise2D_AVX2(parameters, xs, zs, out, count);
+#endif
+
+        case NoiseInstructionSet::SSE2:
+            return FractalNoise2D_SSE2(parameters, xs, zs, out, count);
+
+        default:
+            return 0;
+        }
+    }
+
+    inline size_t RidgedNoise2D(const FractalParameters& parameters, const float* xs, const float* zs, float* out, size_t count)
+    {
+        switch (ActiveInstructionSet())
+        {
+
+#ifdef NOISE_SIMD_X86
+        case NoiseInstructionSet::AVX2:
+            return RidgedNoise2D_AVX2(parameters, xs, zs, out, count);
+#endif
+
+        case NoiseInstructionSet::SSE2:
+            return RidgedNoise2D_SSE2(parameters, xs, zs, out, count);
+
+        default:
+            return 0;
+        }
+    }
+
+    inline size_t CellularNoise2D(const CellularParameters& parameters, const float* xs, const float* zs, float* outF1, float* outF2, int32_t* outId1, int32_t* outId2, size_t count)
+    {
+        switch (ActiveInstructionSet())
+        {
+
+#ifdef NOISE_SIMD_X86
+        case NoiseInstructionSet::AVX2:
+            return CellularNoise2D_AVX2(parameters, xs, zs, outF1, outF2, outId1, outId2, count);
+#endif
+
+        case NoiseInstructionSet::SSE2:
+            return CellularNoise2D_SSE2(parameters, xs, zs, outF1, outF2, outId1, outId2, count);
+
+        default:
+            return 0;
+        }
+    }
+
+    inline size_t FillRow2D(const GridRowParameters& parameters, float* out, size_t count)
+    {
+        switch (ActiveInstructionSet())
+        {
+
+#ifdef NOISE_SIMD_X86
+        case NoiseInstructionSet::AVX2:
+            return FillRow2D_AVX2(parameters, out, count);
+#endif
+
+        case NoiseInstructionSet::SSE2:
+            return FillRow2D_SSE2(parameters, out, count);
+
+        default:
+            return 0;
+        }
+    }
+
+    inline size_t FillRow2DDeriv(const GridRowParameters& parameters, float* out, float* outDx, float* outDy, size_t count)
+    {
+        switch (ActiveInstructionSet())
+        {
+
+#ifdef NOISE_SIMD_X86
+        case NoiseInstructionSet::AVX2:
+            return FillRow2DDeriv_AVX2(parameters, out, outDx, outDy, count);
+#endif
+
+        case NoiseInstructionSet::SSE2:
+            return FillRow2DDeriv_SSE2(parameters, out, outDx, outDy, count);
+
+        default:
+            return 0;
+        }
+    }
+
+    inline size_t FractalNoise3D(const FractalParameters& parameters, const float* xs, const float* ys, const float* zs, float* out, size_t count)
+    {
+        switch (ActiveInstructionSet())
+        {
+
+#ifdef NOISE_SIMD_X86
+        case NoiseInstructionSet::AVX2:
+            return FractalNoise3D_AVX2(parameters, xs, ys, zs, out, count);
+#endif
+
+        case NoiseInstructionSet::SSE2:
+            return FractalNoise3D_SSE2(parameters, xs, ys, zs, out, count);
+
+        default:
+            return 0;
+        }
+    }
+}
+
+#endif // !NOISE_SIMD_HPP
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef INDEX_BUFFER_MANAGER_HPP
+#define INDEX_BUFFER_MANAGER_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+// An immutable element buffer that any number of RenderableObjects can draw with, e.g. one per terrain grid size.
+struct SharedIndexBuffer
+{
+	std::string name = "";
+	unsigned int buffer = 0;
+	unsigned int count = 0;
+	unsigned int type = GL_UNSIGNED_INT;
+
+	void CleanUp()
+	{
+		glDeleteBuffers(1, &buffer);
+		buffer = 0;
+	}
+
+	static SharedIndexBuffer Register(const std::string& name, const std::vector<uint16_t>& indices)
+	{
+		return Register(name, indices.data(), static_cast<unsigned int>(indices.size()), GL_UNSIGNED_SHORT, sizeof(uint16_t));
+	}
+
+	static SharedIndexBuffer Register(const std::string& name, const std::vector<unsigned int>& indices)
+	{
+		return Register(name, indices.data(), static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, sizeof(unsigned int));
+	}
+
+private:
+
+	static SharedIndexBuffer Register(const std::string& name, const void* indices, unsigned int count, unsigned int type, size_t size)
+	{
+		SharedIndexBuffer out = {};
+
+		out.name = name;
+		out.count = count;
+		out.type = type;
+
+		// Filled through the copy target, the element array binding belongs to whichever VAO is bound and the last one drawn
+		// usually still is.
+		glGenBuffers(1, &out.buffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, out.buffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, count * size, indices, GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		return out;
+	}
+};
+
+namespace IndexBufferManager
+{
+	extern std::map<std::string, SharedIndexBuffer> registeredBuffers;
+
+	void RegisterBuffer(const SharedIndexBuffer& buffer)
+	{
+		registeredBuffers.insert({ buffer.name, buffer });
+	}
+
+	bool HasBuffer(const std::string& name)
+	{
+		return registeredBuffers.count(name) != 0;
+	}
+
+	const SharedIndexBuffer& GetBuffer(const std::string& name)
+	{
+		return registeredBuffers[name];
+	}
+
+	void CleanUp()
+	{
+		for (auto& [key, value] : registeredBuffers)
+			value.CleanUp();
+
+		registeredBuffers.clear();
+	}
+}
+
+std::map<std::string, SharedIndexBuffer> IndexBufferManager::registeredBuffers;
+
+#endif // !INDEX_BUFFER_MANAGER_HPP
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include "core/EventSystem.hpp"
 #include "math/Transform.hpp"
 #include "rendering/Camera.hpp"
+#include "rendering/IndexBufferManager.hpp"
 #include "rendering/ShaderManager.hpp"
 #include "rendering/ShadowManager.hpp"
 #include "rendering/TextureManager.hpp"
@@ -111,13 +112,17 @@ struct RenderableData : public IPackagable
 
 	std::vector<Vertex> vertices = {};
 	std::vector<unsigned int> indices = {};
+
+	// Set by UseSharedIndices, the EBO then belongs to IndexBufferManager and indices stays empty.
+	bool sharedIndices = false;
+	unsigned int indexCount = 0;
+	unsigned int indexType = GL_UNSIGNED_INT;
+
 	std::map<std::string, unsigned int> buffers =
 	{
 		{"VAO", 0},
 		{"VBO", 0},
 		{"EBO", 0},
-		{"depthMap", 0},
-		{"depthMapFBO", 0},
 	};
 };
 
@@ -148,14 +153,21 @@ public:
 
 	RenderableData data;
 
+	// Programs and textures from ShaderManager::GetGeneratedShader and TextureManager::GetGeneratedTexture are used as they
+	// are, everything else is generated here and belongs to this object until CleanUp.
 	void GenerateRawData()
 	{
-		data.shaders["default"].GenerateShader();
-		data.shaders["shadow"].GenerateShader();
+		for (const std::string& shader : { "default", "shadow" })
+		{
+			if (!data.shaders[shader].shared)
+				data.shaders[shader].GenerateShader();
+		}
 
 		glGenVertexArrays(1, &data.buffers["VAO"]);
 		glGenBuffers(1, &data.buffers["VBO"]);
-		glGenBuffers(1, &data.buffers["EBO"]);
+
+		if (!data.sharedIndices)
+			glGenBuffers(1, &data.buffers["EBO"]);
 
 		glBindVertexArray(data.buffers["VAO"]);
 
@@ -165,15 +177,16 @@ public:
 		glBindVertexArray(0);
 
 		for (auto& [key, value] : data.textures)
-			value.GenerateTexture();
-
-		data.buffers["depthMap"] = ShadowManager::CreateMap(data.buffers["depthMapFBO"]);
+		{
+			if (!value.shared)
+				value.GenerateTexture();
+		}
 
 		if (!data.advanced)
 		{
 			data.shaders["default"].Use();
 			data.shaders["default"].SetUniform("texture_diffuse1", 0);
-			data.shaders["default"].SetUniform("shadowMap", 1);
+			data.shaders["default"].SetUniform("shadowMap", SHADOW_MAP_UNIT);
 		}
 	}
 
@@ -240,7 +253,7 @@ public:
 		data.advanced = false;
 		data.transform = TRANSFORM_DEFAULT;
 		data.shaders["default"] = ShaderManager::GetShader(ShaderType::DEFAULT);
-		RegisterTexture(TextureManager::GetTexture("test_texture"));
+		RegisterTexture(TextureManager::GetGeneratedTexture("test_texture"));
 
 		ReRegister(vertices, indices);
 		GenerateRawData();
@@ -311,7 +324,9 @@ public:
 			glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(Vertex), data.vertices.data(), GL_STATIC_DRAW);
 
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.buffers["EBO"]);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(unsigned int), data.indices.data(), GL_STATIC_DRAW);
+
+			if (!data.sharedIndices)
+				glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(unsigned int), data.indices.data(), GL_STATIC_DRAW);
 
 			return;
 		}
@@ -331,6 +346,10 @@ public:
 
 			data.bufferCalls.pop_front();
 		}
+
+		// The shared EBO is already filled, it only has to be bound into this VAO.
+		if (data.sharedIndices)
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.buffers["EBO"]);
 	}
 
 	static RenderableObject* Register(const std::string& name, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, bool advanced = false, bool completelyReplaceGLPointerCalls = false, const ShaderObject& shader = ShaderManager::GetShader(ShaderType::DEFAULT))
@@ -348,6 +367,24 @@ public:
 		return out;
 	}
 
+	// Overwrites size bytes of the VBO from offset, for objects that keep their vertex data around to edit it.
+	void UpdateVertexData(size_t offset, size_t size, const void* source)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, data.buffers["VBO"]);
+		glBufferSubData(GL_ARRAY_BUFFER, offset, size, source);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	// Draws with buffer instead of a private EBO, the indices are neither copied nor uploaded for this object.
+	void UseSharedIndices(const SharedIndexBuffer& buffer)
+	{
+		data.indices.clear();
+		data.sharedIndices = true;
+		data.buffers["EBO"] = buffer.buffer;
+		data.indexCount = buffer.count;
+		data.indexType = buffer.type;
+	}
+
 	void RegisterTexture(const Texture& texture)
 	{
 		data.textures.insert({ texture.name, texture });
@@ -365,13 +402,26 @@ public:
 
 		glDeleteVertexArrays(1, &data.buffers["VAO"]);
 		glDeleteBuffers(1, &data.buffers["VBO"]);
-		glDeleteBuffers(1, &data.buffers["EBO"]);
+
+		if (!data.sharedIndices)
+			glDeleteBuffers(1, &data.buffers["EBO"]);
+
+		for (auto& [key, value] : data.textures)
+		{
+			if (!value.shared)
+				value.CleanUp();
+		}
+
+		for (auto& [key, value] : data.shaders)
+		{
+			if (!value.shared)
+				value.CleanUp();
+		}
 
 		data.vertices.clear();
 		data.indices.clear();
 		data.buffers.clear();
-
-		data.shaders["default"].CleanUp();
+		data.textures.clear();
 
 		Logger_FunctionEnd;
 
@@ -393,6 +443,14 @@ namespace Renderer
 		renderableObjects.insert({object->data.name, object});
 	}
 
+	void UnregisterRenderableObject(RenderableObject* object)
+	{
+		auto iterator = renderableObjects.find(object->data.name);
+
+		if (iterator != renderableObjects.end() && iterator->second == object)
+			renderableObjects.erase(iterator);
+	}
+
 	template<typename T>
 	void RequestShaderCall(const std::string& objectName, const std::string& variableName, T value)
 	{
@@ -453,17 +511,18 @@ namespace Renderer
 
 		glBindVertexArray(value->data.buffers["VAO"]);
 
+		const unsigned int count = value->data.sharedIndices ? value->data.indexCount : static_cast<unsigned int>(value->data.indices.size());
+		const unsigned int type = value->data.sharedIndices ? value->data.indexType : GL_UNSIGNED_INT;
+
 		if (drawLines)
-			glDrawElements(GL_LINES, value->data.indices.size(), GL_UNSIGNED_INT, 0);
+			glDrawElements(GL_LINES, count, type, 0);
 		else
-			glDrawElements(GL_TRIANGLES, value->data.indices.size(), GL_UNSIGNED_INT, 0);
+			glDrawElements(GL_TRIANGLES, count, type, 0);
 	}
 
-	glm::mat4 RenderShadows(RenderableObject*& value, Camera& camera)
+	// Draws every object into the shared depth map, once per frame before RenderObjects draws them to the screen.
+	glm::mat4 RenderShadows(Camera& camera)
 	{
-		glm::mat4 model = glm::mat4(1.0f);
-		model = glm::translate(model, value->data.transform.position);
-
 		glm::mat4 lightProjection, lightView;
 		glm::mat4 lightSpaceMatrix;
 		float near_plane = 1.0f, far_plane = 7.5f;
@@ -471,45 +530,81 @@ namespace Renderer
 		lightProjection = glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, near_plane, far_plane);
 		lightView = glm::lookAt({0.0f, 5.0f, 0.0f}, glm::vec3(0.0f), glm::vec3(0.0, 1.0, 0.0));
 		lightSpaceMatrix = lightProjection * lightView;
-		
-		value->data.shaders["shadow"].Use();
-		value->data.shaders["shadow"].SetUniform("lightSpaceMatrix", lightSpaceMatrix);
-		value->data.shaders["shadow"].SetUniform("model", model);
 
-		glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
-		glBindFramebuffer(GL_FRAMEBUFFER, value->data.buffers["depthMapFBO"]);
+		unsigned int program = 0;
 
+		glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
+		glBindFramebuffer(GL_FRAMEBUFFER, ShadowManager::GetMap().fbo);
 		glClear(GL_DEPTH_BUFFER_BIT);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, value->data.buffers["depthMap"]);
 
-		RenderArea(value, value->data.shaders["shadow"], camera);
+		for (auto& [key, value] : renderableObjects)
+		{
+			ShaderObject& shader = value->data.shaders["shadow"];
+
+			// Objects sharing a program only need the per frame uniforms set once.
+			if (shader.shaderProgram != program)
+			{
+				program = shader.shaderProgram;
+
+				shader.Use();
+				shader.SetUniform("lightSpaceMatrix", lightSpaceMatrix);
+				shader.SetUniform("viewPos", camera.data.transform.position);
+			}
+
+			for (auto const& [key, texture] : value->data.textures)
+			{
+				if (texture.unit < 0)
+					continue;
+
+				glActiveTexture(GL_TEXTURE0 + texture.unit);
+				glBindTexture(GL_TEXTURE_2D, texture.textureID);
+			}
+
+			RenderArea(value, shader, camera);
+		}
 
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
+		// The screen was cleared by Window::UpdateColors at the start of the frame, the shadow pass never touches it.
 		glViewport(0, 0, Window::mainWindow.data.size.x, Window::mainWindow.data.size.y);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		return lightSpaceMatrix;
 	}
 
 	void RenderObjects(Camera camera)
 	{
+		const glm::mat4 lightSpaceMatrix = RenderShadows(camera);
+		const unsigned int depthMap = ShadowManager::GetMap().depthMap;
+		unsigned int program = 0;
+
 		for (auto& [key, value] : renderableObjects)
 		{
-			glm::mat4 lightSpaceMatrix = RenderShadows(value, camera);
-
 			int count = 0;
 			unsigned int diffuseNr = 1;
 			unsigned int specularNr = 1;
 			unsigned int normalNr = 1;
 
-			value->data.shaders["default"].Use();
-			value->data.shaders["default"].SetUniform("projection", camera.data.matrices.projection);
-			value->data.shaders["default"].SetUniform("view", camera.data.matrices.view);
+			ShaderObject& shader = value->data.shaders["default"];
+
+			if (shader.shaderProgram != program)
+			{
+				program = shader.shaderProgram;
+
+				shader.Use();
+				shader.SetUniform("projection", camera.data.matrices.projection);
+				shader.SetUniform("view", camera.data.matrices.view);
+				shader.SetUniform("lightSpaceMatrix", lightSpaceMatrix);
+			}
 
 			for (auto const& [key, texture] : value->data.textures)
 			{
+				if (texture.unit >= 0)
+				{
+					glActiveTexture(GL_TEXTURE0 + texture.unit);
+					glBindTexture(GL_TEXTURE_2D, texture.textureID);
+					continue;
+				}
+
 				glActiveTexture(GL_TEXTURE0 + count);
 
 				if (value->data.advanced)
@@ -523,20 +618,21 @@ namespace Renderer
 					else if (name == TextureType::NORMAL)
 						number = std::to_string(normalNr++);
 
-					value->data.shaders["default"].SetUniform((TextureType2String(name) + number), count);
+					shader.SetUniform((TextureType2String(name) + number), count);
 				}
 				
 				glBindTexture(GL_TEXTURE_2D, texture.textureID);
 
 				++count;
 			}
-			
-			glActiveTexture(GL_TEXTURE0 + count + 1);
-			glBindTexture(GL_TEXTURE_2D, value->data.buffers["depthBuffer"]);
 
-			value->data.shaders["default"].SetUniform("lightSpaceMatrix", lightSpaceMatrix);
+			if (!value->data.advanced)
+			{
+				glActiveTexture(GL_TEXTURE0 + SHADOW_MAP_UNIT);
+				glBindTexture(GL_TEXTURE_2D, depthMap);
+			}
 
-			RenderArea(value, value->data.shaders["default"], camera);
+			RenderArea(value, shader, camera);
 
 			int error = glGetError();
 
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <map>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include "core/Settings.hpp"
@@ -15,7 +16,11 @@ enum class ShaderType
 {
 	DEFAULT,
 	CHUNK,
-	SHADOW
+	SHADOW,
+	CHUNK_SHADOW,
+	CHUNK_DISPLACEMENT,
+	CHUNK_DISPLACEMENT_SHADOW,
+	VOXEL
 };
 
 struct ShaderObject
@@ -26,6 +31,9 @@ struct ShaderObject
 
 	unsigned int shaderProgram = 0;
 
+	// Set by ShaderManager::GetGeneratedShader, the program then belongs to ShaderManager and objects leave it alone.
+	bool shared = false;
+
 	unsigned int CompileShader(GLenum type, const std::string& source) const  
 	{
 		unsigned int shader = glCreateShader(type);
@@ -173,6 +181,7 @@ struct ShaderObject
 	void CleanUp()
 	{
 		glDeleteProgram(shaderProgram);
+		shaderProgram = 0;
 	}
 
 	static ShaderObject Register(const std::string& path, ShaderType type, const std::string& domain = Settings::defaultDomain)
@@ -189,11 +198,28 @@ struct ShaderObject
 
 		return out;
 	}
+
+	// For shaders that share one stage with another, the paths are full file names relative to the domain.
+	static ShaderObject Register(const std::string& vertexPath, const std::string& fragmentPath, ShaderType type, const std::string& domain = Settings::defaultDomain)
+	{
+		ShaderObject out = {};
+
+		out.type = type;
+
+		out.vertexPath = "assets/" + domain + "/" + vertexPath;
+		out.fragmentPath = "assets/" + domain + "/" + fragmentPath;
+
+		out.vertexData = LoadFile(out.vertexPath);
+		out.fragmentData = LoadFile(out.fragmentPath);
+
+		return out;
+	}
 };
 
 namespace ShaderManager
 {
 	extern std::vector<ShaderObject> registeredShaders;
+	extern std::map<std::string, ShaderObject> generatedShaders;
 
 	void RegisterShader(ShaderObject object)
 	{
@@ -208,8 +234,38 @@ namespace ShaderManager
 				return object;
 		}
 	}
+
+	// The shader registered for type, compiled once under name for every object that draws with it. created tells the first
+	// caller to set the uniforms all of them share.
+	ShaderObject GetGeneratedShader(const std::string& name, ShaderType type, bool* created = nullptr)
+	{
+		auto iterator = generatedShaders.find(name);
+
+		if (created)
+			*created = iterator == generatedShaders.end();
+
+		if (iterator != generatedShaders.end())
+			return iterator->second;
+
+		ShaderObject shader = GetShader(type);
+
+		shader.GenerateShader();
+		shader.shared = true;
+		generatedShaders.insert({ name, shader });
+
+		return shader;
+	}
+
+	void CleanUp()
+	{
+		for (auto& [key, value] : generatedShaders)
+			value.CleanUp();
+
+		generatedShaders.clear();
+	}
 }
 
 std::vector<ShaderObject> ShaderManager::registeredShaders;
+std::map<std::string, ShaderObject> ShaderManager::generatedShaders;
 
 #endif // !SHADER_MANAGER_HPP
\ No newline at end of file
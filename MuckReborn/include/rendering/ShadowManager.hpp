@@ -10,8 +10,19 @@
 #define SHADOW_WIDTH 1024
 #define SHADOW_HEIGHT 1024
 
+// Texture unit the default pass samples the shadow map from, RenderableObject::GenerateRawData points shadowMap at it.
+#define SHADOW_MAP_UNIT 1
+
+struct ShadowMap
+{
+	unsigned int depthMap = 0;
+	unsigned int fbo = 0;
+};
+
 namespace ShadowManager
 {
+	extern ShadowMap map;
+
 	unsigned int CreateMap(unsigned int& fbo)
 	{
         unsigned int depthMapFBO;
@@ -37,6 +48,25 @@ namespace ShadowManager
         fbo = depthMapFBO;
         return depthMap;
 	}
+
+	// The one depth map every object renders into each frame, made the first time it's asked for.
+	const ShadowMap& GetMap()
+	{
+		if (map.fbo == 0)
+			map.depthMap = CreateMap(map.fbo);
+
+		return map;
+	}
+
+	void CleanUp()
+	{
+		glDeleteFramebuffers(1, &map.fbo);
+		glDeleteTextures(1, &map.depthMap);
+
+		map = {};
+	}
 }
 
+ShadowMap ShadowManager::map;
+
 #endif // !SHADOW_MANAGER_HPP
\ No newline at end of file
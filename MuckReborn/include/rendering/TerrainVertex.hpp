@@ -0,0 +1,90 @@
+#ifndef TERRAIN_VERTEX_HPP
+#define TERRAIN_VERTEX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include "rendering/Renderer.hpp"
+
+// Biome tints go past 1, colors are stored as a fraction of this and scaled back up by the chunk shaders.
+#define TERRAIN_VERTEX_COLOR_RANGE 2.0f
+
+// 12 byte terrain vertex, decoded by chunkVertex.glsl. Heights are whole steps of a world wide quantum so neighbouring
+// chunks quantize their shared border to the same value, x and z are grid indices and the normal is octahedral.
+struct TerrainVertex : public IPackagable
+{
+	int16_t height = 0;
+	int16_t morph = 0;
+	uint8_t x = 0, z = 0;
+	int8_t normal[2] = { 0, 0 };
+	uint8_t color[4] = { 0, 0, 0, 255 };
+
+	// Heights past 32767 quanta from zero are clamped.
+	static int16_t QuantizeHeight(float height, float heightQuantum)
+	{
+		return static_cast<int16_t>(std::clamp(std::lround(height / heightQuantum), -32767L, 32767L));
+	}
+
+	// Folds the normal onto the octahedron |x| + |y| + |z| = 1 seen from +y, the lower half mirrored over its diagonals.
+	static glm::vec2 EncodeNormal(const glm::vec3& normal)
+	{
+		const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+		glm::vec2 out = { normal.x / length, normal.z / length };
+
+		if (normal.y < 0.0f)
+			out = { (1.0f - std::abs(out.y)) * (out.x >= 0.0f ? 1.0f : -1.0f), (1.0f - std::abs(out.x)) * (out.y >= 0.0f ? 1.0f : -1.0f) };
+
+		return out;
+	}
+
+	static glm::vec3 DecodeNormal(const glm::vec2& encoded)
+	{
+		glm::vec3 out = { encoded.x, 1.0f - std::abs(encoded.x) - std::abs(encoded.y), encoded.y };
+
+		if (out.y < 0.0f)
+		{
+			out.x = (1.0f - std::abs(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f);
+			out.z = (1.0f - std::abs(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f);
+		}
+
+		return glm::normalize(out);
+	}
+
+	// vertex.position.x and z have to be whole multiples of 1 / resolution, vertex.textureCoords.x is the morph height.
+	static TerrainVertex Register(const Vertex& vertex, int resolution, float heightQuantum)
+	{
+		TerrainVertex out = {};
+		const glm::vec2 normal = EncodeNormal(vertex.normal);
+
+		out.height = QuantizeHeight(vertex.position.y, heightQuantum);
+		out.morph = QuantizeHeight(vertex.textureCoords.x, heightQuantum);
+		out.x = static_cast<uint8_t>(std::lround(vertex.position.x * resolution));
+		out.z = static_cast<uint8_t>(std::lround(vertex.position.z * resolution));
+		out.normal[0] = static_cast<int8_t>(std::lround(std::clamp(normal.x, -1.0f, 1.0f) * 127.0f));
+		out.normal[1] = static_cast<int8_t>(std::lround(std::clamp(normal.y, -1.0f, 1.0f) * 127.0f));
+
+		for (int i = 0; i < 3; i++)
+			out.color[i] = static_cast<uint8_t>(std::lround(std::clamp(vertex.color[i] / TERRAIN_VERTEX_COLOR_RANGE, 0.0f, 1.0f) * 255.0f));
+
+		return out;
+	}
+
+	// Replaces the default Vertex layout, for objects registered with completelyReplaceGLPointerCalls. The normal is read
+	// unnormalized and divided by 127 in the shader, GL 3.3 maps normalized bytes with (2c + 1) / 255 and misses zero.
+	static std::vector<GLPointerCall> GetPointerCalls()
+	{
+		return
+		{
+			GLPointerCall::Register(0, 2, GL_SHORT, false, sizeof(TerrainVertex), (void*)offsetof(TerrainVertex, height), 0, "height", GLPointerType::D),
+			GLPointerCall::Register(1, 4, GL_UNSIGNED_BYTE, true, sizeof(TerrainVertex), (void*)offsetof(TerrainVertex, color), 1, "color", GLPointerType::D),
+			GLPointerCall::Register(2, 2, GL_BYTE, false, sizeof(TerrainVertex), (void*)offsetof(TerrainVertex, normal), 2, "normal", GLPointerType::D),
+			GLPointerCall::Register(3, 2, GL_UNSIGNED_BYTE, false, sizeof(TerrainVertex), (void*)offsetof(TerrainVertex, x), 3, "grid", GLPointerType::D),
+		};
+	}
+};
+
+static_assert(sizeof(TerrainVertex) == 12, "TerrainVertex has to stay tightly packed");
+
+#endif // !TERRAIN_VERTEX_HPP
\ No newline at end of file
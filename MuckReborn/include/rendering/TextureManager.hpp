@@ -81,6 +81,17 @@ struct Texture : IPackagable
 	unsigned int textureID = 0;
     unsigned char* data = NULL;
 
+    // Set by RegisterData, uploaded as given instead of loading path.
+    unsigned int internalFormat = 0, dataFormat = 0, dataType = 0;
+    const void* pixels = nullptr;
+
+    // Texture unit the renderer binds this to in the shadow pass as well as the default one, for textures a vertex shader
+    // reads. -1 takes the next free unit, in the default pass only.
+    int unit = -1;
+
+    // Set by TextureManager::GetGeneratedTexture, the texture then belongs to TextureManager and objects leave it alone.
+    bool shared = false;
+
     void GenerateTexture()
     {
         glGenTextures(1, &textureID);
@@ -95,6 +106,12 @@ struct Texture : IPackagable
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
+        if (path.empty())
+        {
+            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, size.x, size.y, 0, dataFormat, dataType, pixels);
+            return;
+        }
+
         int nrComponents;
         stbi_set_flip_vertically_on_load(properties.flip);
 
@@ -127,6 +144,21 @@ struct Texture : IPackagable
         stbi_image_free(data);
     }
 
+    // Replaces regionSize texels at offset with source, whose rows are rowLength texels apart.
+    void UpdateRegion(const glm::ivec2& offset, const glm::ivec2& regionSize, const void* source, int rowLength) const
+    {
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, offset.x, offset.y, regionSize.x, regionSize.y, dataFormat, dataType, source);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    void CleanUp()
+    {
+        glDeleteTextures(1, &textureID);
+        textureID = 0;
+    }
+
 	static Texture Register(const std::string& localPath, const std::string& name, const TextureProperties& properties = DEFAULT_TEXTURE_PROPERTIES, const std::string& domain = Settings::defaultDomain)
 	{
 		Texture out = {};
@@ -138,6 +170,22 @@ struct Texture : IPackagable
 		return out;
 	}
 
+    // A texture made from memory, pixels has to stay valid until GenerateTexture. Integer formats need GL_NEAREST.
+    static Texture RegisterData(const std::string& name, const glm::ivec2& size, unsigned int internalFormat, unsigned int dataFormat, unsigned int dataType, const void* pixels, const TextureProperties& properties = DEFAULT_TEXTURE_PROPERTIES)
+    {
+        Texture out = {};
+
+        out.name = name;
+        out.size = size;
+        out.internalFormat = internalFormat;
+        out.dataFormat = dataFormat;
+        out.dataType = dataType;
+        out.pixels = pixels;
+        out.properties = properties;
+
+        return out;
+    }
+
     static Texture RegisterGlobalPath(const std::string& path, const std::string& name, const TextureProperties& properties = DEFAULT_TEXTURE_PROPERTIES)
     {
         Texture out = {};
@@ -163,6 +211,32 @@ namespace TextureManager
     {
         return registeredTextures[name];
     }
+
+    // The registered texture uploaded once, every object given it draws with the same GL texture.
+    Texture GetGeneratedTexture(const std::string& name)
+    {
+        Texture& texture = registeredTextures[name];
+
+        if (!texture.shared)
+        {
+            texture.GenerateTexture();
+            texture.shared = true;
+        }
+
+        return texture;
+    }
+
+    void CleanUp()
+    {
+        for (auto& [key, value] : registeredTextures)
+        {
+            if (!value.shared)
+                continue;
+
+            value.CleanUp();
+            value.shared = false;
+        }
+    }
 }
 
 #endif // !TEXTURE_HPP
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef BIOME_MAP_HPP
+#define BIOME_MAP_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "math/Noise.hpp"
+
+#define BIOME_COUNT 4
+
+enum class BiomeType
+{
+	PLAINS,
+	FOREST,
+	DESERT,
+	SNOW
+};
+
+struct BiomeTile
+{
+	glm::vec2 origin = { 0.0f, 0.0f };
+	float step = 0.125f;
+	int resolution = 0;
+
+	std::vector<uint8_t> biomes = {};
+
+	// BIOME_COUNT planes of resolution^2 weights, each column's weights sum to one.
+	std::vector<float> weights = {};
+
+	BiomeType Get(int x, int z) const
+	{
+		return static_cast<BiomeType>(biomes[z * resolution + x]);
+	}
+
+	float GetWeight(BiomeType biome, int x, int z) const
+	{
+		return GetWeights(biome)[z * resolution + x];
+	}
+
+	const float* GetWeights(BiomeType biome) const
+	{
+		return weights.data() + static_cast<size_t>(biome) * resolution * resolution;
+	}
+
+	static BiomeTile Register(const glm::vec2& origin, float step, int resolution)
+	{
+		BiomeTile out = {};
+
+		out.origin = origin;
+		out.step = step;
+		out.resolution = resolution;
+		out.biomes.resize(static_cast<size_t>(resolution) * resolution);
+		out.weights.resize(out.biomes.size() * BIOME_COUNT);
+
+		return out;
+	}
+};
+
+struct BiomeMap
+{
+	float frequency = 0.02f;
+	float jitter = 0.9f;
+
+	// Width of the cross-fade at a cell border, in cell units of F2 - F1.
+	float blendWidth = 0.2f;
+
+	glm::vec3 colors[BIOME_COUNT] = {};
+
+	void Generate(const Noise& noise, BiomeTile& tile) const
+	{
+		const size_t count = tile.biomes.size();
+
+		std::vector<float> f1(count), f2(count);
+		std::vector<int32_t> id1(count), id2(count);
+
+		noise.FillCellularGrid2D(tile.origin.x, tile.origin.y, tile.step, tile.resolution, tile.resolution, frequency, jitter, f1.data(), f2.data(), id1.data(), id2.data());
+
+		std::vector<float> nearest(count);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			float t = glm::min((f2[i] - f1[i]) / blendWidth, 1.0f);
+			t = t * t * (3.0f - 2.0f * t);
+
+			nearest[i] = 0.5f + 0.5f * t;
+			id1[i] = id1[i] % BIOME_COUNT;
+			id2[i] = id2[i] % BIOME_COUNT;
+			tile.biomes[i] = static_cast<uint8_t>(id1[i]);
+		}
+
+		for (int32_t biome = 0; biome < BIOME_COUNT; biome++)
+		{
+			float* plane = tile.weights.data() + biome * count;
+
+			for (size_t i = 0; i < count; i++)
+				plane[i] = (id1[i] == biome ? nearest[i] : 0.0f) + (id2[i] == biome ? 1.0f - nearest[i] : 0.0f);
+		}
+	}
+
+	glm::vec3 GetColor(const BiomeTile& tile, int x, int z) const
+	{
+		glm::vec3 out = { 0.0f, 0.0f, 0.0f };
+
+		for (int biome = 0; biome < BIOME_COUNT; biome++)
+			out += colors[biome] * tile.GetWeight(static_cast<BiomeType>(biome), x, z);
+
+		return out;
+	}
+
+	static BiomeMap Register(float frequency, float blendWidth)
+	{
+		BiomeMap out = {};
+
+		out.frequency = frequency;
+		out.blendWidth = blendWidth;
+
+		out.colors[static_cast<int>(BiomeType::PLAINS)] = { 1.0f, 1.0f, 1.0f };
+		out.colors[static_cast<int>(BiomeType::FOREST)] = { 0.75f, 0.95f, 0.75f };
+		out.colors[static_cast<int>(BiomeType::DESERT)] = { 1.2f, 1.1f, 0.8f };
+		out.colors[static_cast<int>(BiomeType::SNOW)] = { 1.25f, 1.25f, 1.3f };
+
+		return out;
+	}
+};
+
+#endif // !BIOME_MAP_HPP
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef BLOCK_HPP
+#define BLOCK_HPP
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+enum class BlockType : uint16_t
+{
+	AIR,
+	STONE,
+	DIRT,
+	GRASS,
+	SAND,
+	WOOD,
+	LEAVES
+};
+
+namespace Block
+{
+	bool IsSolid(BlockType type)
+	{
+		return type != BlockType::AIR;
+	}
+
+	// Tint chunkFragment.glsl multiplies its lighting by.
+	glm::vec3 GetColor(BlockType type)
+	{
+		switch (type)
+		{
+		case BlockType::STONE: return { 0.55f, 0.55f, 0.6f };
+		case BlockType::DIRT: return { 0.55f, 0.4f, 0.25f };
+		case BlockType::GRASS: return { 0.45f, 0.75f, 0.3f };
+		case BlockType::SAND: return { 0.95f, 0.85f, 0.6f };
+		case BlockType::WOOD: return { 0.5f, 0.35f, 0.2f };
+		case BlockType::LEAVES: return { 0.3f, 0.6f, 0.25f };
+		default: return { 1.0f, 1.0f, 1.0f };
+		}
+	}
+}
+
+#endif // !BLOCK_HPP
\ No newline at end of file
@@ -4,16 +4,59 @@
 #include "math/Noise.hpp"
 #include "rendering/Renderer.hpp"
 #include "util/General.hpp"
+#include "world/BiomeMap.hpp"
+#include "world/ChunkStage.hpp"
+#include "world/EditLayer.hpp"
+#include "world/Erosion.hpp"
+#include "world/Heightfield.hpp"
+#include "world/RegionFile.hpp"
+#include "world/TerrainBrush.hpp"
+#include "world/TerrainLod.hpp"
+#include "world/TerrainMesher.hpp"
 
 #define CHUNK_SIZE 6
+#define CHUNK_RESOLUTION 8
+#define CHUNK_EROSION_ITERATIONS 4096
+
+// Level 0 is meshed at CHUNK_RESOLUTION out to CHUNK_LOD_DISTANCE, each level after it at half the resolution of the one before.
+#define CHUNK_LOD_LEVELS 4
+#define CHUNK_LOD_DISTANCE 24.0f
+#define CHUNK_SKIRT_DEPTH 0.25f
+
+// Heights are uploaded in whole steps of this, 16 bits of it reach 32 units above and below zero.
+#define CHUNK_HEIGHT_QUANTUM (1.0f / 1024.0f)
+
+// Upload chunks as a heightmap texture the vertex shader displaces a shared grid with, instead of vertex buffers.
+#define CHUNK_GPU_DISPLACEMENT false
+
+// Unit the heightmap sits on in both passes, clear of the ones the renderer hands out for other textures and the shadow maps.
+#define CHUNK_HEIGHTMAP_UNIT 4
+
+static_assert(CHUNK_LOD_LEVELS >= 1 && CHUNK_LOD_LEVELS <= 4, "Chunk::DispatchLevel meshes at most four levels");
+static_assert(CHUNK_RESOLUTION % (1 << (CHUNK_LOD_LEVELS - 1)) == 0, "CHUNK_RESOLUTION has to halve evenly for every level");
+
+// Edits reach one coarsest level sample past the chunk, which is what that level's normals are taken across.
+#define CHUNK_EDIT_APRON (1 << (CHUNK_LOD_LEVELS - 1))
+
+// Also save the procedural heights of every level 0 chunk visited, so coming back skips the noise and erosion. Costs disk
+// per chunk explored instead of per chunk edited, edits are saved either way.
+#define CHUNK_CACHE_HEIGHTS false
+
+// Screen error a coarser noise tier may add, in pixels on a CHUNK_QUALITY_SCREEN_HEIGHT pixel tall screen with the
+// camera's default field of view, at the nearest a chunk of its level gets. The tier bounds are worst cases, with
+// Noise(0.45, 10) REDUCED needs about 8 pixels at every level and APPROXIMATE far more.
+#define CHUNK_QUALITY_PIXELS 2.0f
+#define CHUNK_QUALITY_SCREEN_HEIGHT 1080.0f
+#define CHUNK_QUALITY_FOV 45.0f
 
 struct ChunkData : IPackagable
 {
 	RenderableObject* object = 0;
 
-	std::vector<Vertex> vertices = {};
-	std::vector<unsigned int> indices = {};
-	int indiceIndex = 0;
+	std::vector<TerrainVertex> vertices = {};
+
+	// TerrainMesher::GenerateHeightmap texels in displacement mode, vertices stays empty then.
+	std::vector<uint16_t> heightmap = {};
 };
 
 class Chunk : IPackagable
@@ -21,97 +64,491 @@ class Chunk : IPackagable
 
 public:
 	
-	void InitalizeChunk(const glm::ivec3& position)
+	void InitalizeChunk(const glm::ivec3& position, float viewDistance = 0.0f)
 	{
-		data.object = new RenderableObject();
+		Prepare(position, viewDistance);
+		Rebuild();
+	}
+
+	// Sets up the CPU side of the chunk, nothing here touches GL so it can run before the chunk is handed to a worker.
+	// A negative level picks the one GetLod gives for viewDistance.
+	void Prepare(const glm::ivec3& position, float viewDistance = 0.0f, int level = -1)
+	{
+		this->position = position;
+		this->level = level < 0 ? GetLod().SelectLevel(viewDistance) : std::min(level, CHUNK_LOD_LEVELS - 1);
 		noise = new Noise(0.45, 10);
 
-		data.object = RenderableObject::Register("Chunk(" + std::to_string(position.x) + ", " + std::to_string(position.y) + ", " + std::to_string(position.z) + ")", {}, {}, false, false, ShaderManager::GetShader(ShaderType::CHUNK));
-		data.object->data.transform.position = position;
+		const int resolution = CHUNK_RESOLUTION >> this->level;
 
-		Rebuild();
+		erosion = HydraulicErosion::Register(CHUNK_EROSION_ITERATIONS, noise->GetSeed());
+		heightfield = Heightfield::Register({ position.x, position.z }, 1.0f / resolution, CHUNK_SIZE * resolution + 1, this->level == 0 ? 1 + erosion.GetHalo() : 1);
+		biomes = BiomeTile::Register({ position.x, position.z }, 1.0f / resolution, CHUNK_SIZE * resolution + 1);
+
+		quality = SelectQuality(this->level);
 	}
 
 	void Rebuild()
 	{
-		data.vertices.clear();
-		data.indices.clear();
-		data.indiceIndex = 0;
+		Generate();
+		Upload();
+	}
+
+	// Runs every stage but the upload in order. Only touches this chunk's own data, safe to call from a worker thread.
+	void Generate()
+	{
+		for (ChunkStage stage = ChunkStage::HEIGHT; stage != ChunkStage::UPLOAD; stage = ChunkStages::GetNext(stage))
+			RunStage(stage);
+	}
+
+	// Every stage but UPLOAD only touches this chunk's own data and is safe on a worker thread, as long as the stages before
+	// it ran first.
+	void RunStage(ChunkStage stage)
+	{
+		switch (stage)
+		{
+		case ChunkStage::HEIGHT: GenerateHeights(); break;
+		case ChunkStage::BIOME: biomeMap.Generate(*noise, biomes); break;
+		case ChunkStage::EROSION: Erode(); break;
+		case ChunkStage::DECORATION: Decorate(); break;
+		case ChunkStage::MESH: Mesh(); break;
+		case ChunkStage::UPLOAD: Upload(); break;
+		default: break;
+		}
+	}
+
+	// Heights come from the payload given to SetSaved when it decodes, which skips the noise and the erosion after it.
+	void GenerateHeights()
+	{
+		generated = !LoadSaved();
+
+		if (!generated)
+			return;
+
+		if (program)
+			heightfield.Generate(*program);
+		else if (fixedNoise)
+			heightfield.Generate(*fixedNoise, CHUNK_SIZE * 4, scale, offset);
+		else
+			heightfield.Generate(*noise, CHUNK_SIZE * 4, scale, offset, quality);
+
+		// The eroded finest level is what's worth keeping, coarser levels are read back from it.
+		modified = CHUNK_CACHE_HEIGHTS && level == 0;
+	}
+
+	void Erode()
+	{
+		// Droplets carve detail far below a coarse level's sample spacing, so only the finest level erodes.
+		if (generated && level == 0 && !fixedNoise)
+			erosion.Erode(heightfield);
+	}
+
+	// Puts what was built on the terrain on top of it, for now the edits given to SetEdits.
+	void Decorate()
+	{
+		if (edits.AddTo(heightfield))
+			heightfield.RecalculateNormals();
+
+		decorated = true;
+	}
+
+	// Copies the samples on the borders neighbours own from them, so both sides of a seam mesh the same heights and normals.
+	// Generated and eroded borders agree already, but heights read back from a region are quantised and get recalculated
+	// normals. neighbours are the chunks at -x, +x, -z and +z, a missing one or one at another level keeps the samples this
+	// chunk has.
+	// The border between two chunks belongs to the one at lower coordinates, which takes the border row and the apron row
+	// past it from the one before it and only the apron row from the one after it. Neither reads a row the other writes,
+	// so the order chunks stitch in doesn't matter. The four corners are shared with a diagonal neighbour and stay as they
+	// were generated. Reads but never writes the neighbours, call between decoration and mesh.
+	void Stitch(const Chunk* const neighbours[4])
+	{
+		const int last = heightfield.resolution - 1;
+
+		// Normals the copied samples are taken across, per face.
+		const glm::ivec4 regions[4] = { { 0, 1, 1, last - 1 }, { last, 1, last, last - 1 }, { 1, 0, last - 1, 1 }, { 1, last, last - 1, last } };
+
+		for (int face = 0; face < 4; face++)
+		{
+			const Chunk* neighbour = neighbours[face];
+
+			if (!neighbour || neighbour->level != level)
+				continue;
+
+			const Heightfield& other = neighbour->heightfield;
+
+			for (int i = 1; i < last; i++)
+			{
+				switch (face)
+				{
+				case 0:
+					heightfield.At(0, i) = other.Get(last, i);
+					heightfield.At(-1, i) = other.Get(last - 1, i);
+					break;
+				case 1:
+					heightfield.At(last + 1, i) = other.Get(1, i);
+					break;
+				case 2:
+					heightfield.At(i, 0) = other.Get(i, last);
+					heightfield.At(i, -1) = other.Get(i, last - 1);
+					break;
+				default:
+					heightfield.At(i, last + 1) = other.Get(i, 1);
+					break;
+				}
+			}
 
-		for (float x = 0; x < CHUNK_SIZE; x += 0.125f)
+			heightfield.RecalculateNormals(regions[face]);
+		}
+	}
+
+	void Mesh()
+	{
+		DispatchLevel([&](auto mesher)
 		{
-			for (float z = 0; z < CHUNK_SIZE; z += 0.125f)
+			using Mesher = decltype(mesher);
+
+			if (displacement)
 			{
-				GenerateQuad({ x, 0, z });
+				data.vertices.clear();
+				data.heightmap.resize(Mesher::HeightmapSize);
+				Mesher::GenerateHeightmap(heightfield, biomeMap, biomes, CHUNK_HEIGHT_QUANTUM, data.heightmap.data());
 			}
+			else
+			{
+				data.heightmap.clear();
+				data.vertices.resize(Mesher::VertexCount);
+				Mesher::GenerateCompactVertices(heightfield, biomeMap, biomes, GetSkirtDepth(), CHUNK_HEIGHT_QUANTUM, data.vertices.data());
+			}
+		});
+	}
+
+	// Main thread only, registers the renderable object the first time and uploads the mesh from Generate.
+	void Upload()
+	{
+		if (!data.object)
+		{
+			data.object = RenderableObject::Register("Chunk(" + std::to_string(position.x) + ", " + std::to_string(position.y) + ", " + std::to_string(position.z) + ")", {}, {}, false, true, ShaderManager::GetShader(ShaderType::CHUNK));
+			data.object->data.transform.position = position;
 		}
 
-		for (Vertex& vertex : data.vertices)
+		data.object->data.shaders["default"] = GetProgram(displacement ? ShaderType::CHUNK_DISPLACEMENT : ShaderType::CHUNK);
+		data.object->data.shaders["shadow"] = GetProgram(displacement ? ShaderType::CHUNK_DISPLACEMENT_SHADOW : ShaderType::CHUNK_SHADOW);
+
+		CleanUpHeightmap();
+
+		if (displacement)
 		{
-			float noiseValue = noise->FractalNoise(CHUNK_SIZE * 4, vertex.position.x, vertex.position.z);
+			// The heightmap has to be the only texture and gets its own unit, the default pass samples the shadow map from
+			// SHADOW_MAP_UNIT. The VAO has no attributes, gl_VertexID indexes the grid through the shared indices.
+			int side = 0;
+
+			DispatchLevel([&](auto mesher) { side = decltype(mesher)::HeightmapSide; });
+			data.object->data.textures.clear();
+
+			Texture heightmap = Texture::RegisterData("heightmap", { side, side }, GL_RG16UI, GL_RG_INTEGER, GL_UNSIGNED_SHORT, data.heightmap.data());
 
-			vertex.position.y = noiseValue * scale + offset;
+			heightmap.unit = CHUNK_HEIGHTMAP_UNIT;
+			data.object->RegisterTexture(heightmap);
+		}
+		else
+		{
+			data.object->RegisterTexture(TextureManager::GetGeneratedTexture("test_texture"));
+			data.object->RequestGLBufferCall(GLBufferCall::Register(GL_ARRAY_BUFFER, static_cast<unsigned int>(data.vertices.size() * sizeof(TerrainVertex)), data.vertices.data(), GL_STATIC_DRAW, "VBO", "vertices"));
+
+			for (const GLPointerCall& call : TerrainVertex::GetPointerCalls())
+				data.object->RequestGLPointerCall(call);
 		}
 
-		data.object->RegisterTexture(TextureManager::GetTexture("test_texture"));
-		data.object->ReRegister(data.vertices, data.indices);
+		DispatchLevel([&](auto mesher) { data.object->UseSharedIndices(decltype(mesher)::GetSharedIndices()); });
 		data.object->GenerateRawData();
 
+		// Nothing takes the edits back out once the chunk is on screen, brushes change its heightfield directly from here.
+		edits = {};
+
 		Renderer::RegisterRenderableObject(data.object);
 	}
 
-	void GenerateQuad(const glm::vec3& position)
+	// Records the edit in layer, this chunk's edits, and pushes only what changed in the heightfield: the dirty vertices with
+	// glBufferSubData, or the dirty texels with glTexSubImage2D in displacement mode. Main thread only, returns whether any
+	// sample of this chunk's level changed.
+	bool ApplyBrush(const TerrainBrush& brush, const glm::vec2& center, float deltaTime, EditLayer& layer)
+	{
+		const glm::ivec4 dirty = layer.Apply(brush, center, deltaTime, heightfield);
+
+		if (dirty.z < dirty.x || dirty.w < dirty.y)
+			return false;
+
+		if (!data.object)
+			return true;
+
+		DispatchLevel([&](auto mesher)
+		{
+			using Mesher = decltype(mesher);
+
+			if (displacement)
+			{
+				const glm::ivec4 texels = Mesher::UpdateHeightmap(heightfield, CHUNK_HEIGHT_QUANTUM, dirty, data.heightmap.data());
+
+				data.object->data.textures["heightmap"].UpdateRegion({ texels.x, texels.y }, { texels.z - texels.x + 1, texels.w - texels.y + 1 }, data.heightmap.data() + (static_cast<size_t>(texels.y) * Mesher::HeightmapSide + texels.x) * 2, Mesher::HeightmapSide);
+				return;
+			}
+
+			const glm::ivec4 region = Mesher::GetVertexRegion(dirty);
+
+			if (region.z < region.x || region.w < region.y)
+				return;
+
+			Mesher::UpdateCompactVertices(heightfield, biomeMap, biomes, GetSkirtDepth(), CHUNK_HEIGHT_QUANTUM, region, data.vertices.data());
+
+			// Rows of the region are Side vertices apart, one upload from its first to its last vertex is cheaper than one per row.
+			const size_t first = static_cast<size_t>(region.y) * Mesher::Side + region.x;
+			const size_t last = static_cast<size_t>(region.w) * Mesher::Side + region.z;
+
+			data.object->UpdateVertexData(first * sizeof(TerrainVertex), (last - first + 1) * sizeof(TerrainVertex), data.vertices.data() + first);
+
+			if (Mesher::IsOnBorder(region))
+				data.object->UpdateVertexData(Mesher::GridVertexCount * sizeof(TerrainVertex), Mesher::SkirtVertexCount * sizeof(TerrainVertex), data.vertices.data() + Mesher::GridVertexCount);
+		});
+
+		return true;
+	}
+
+	// A payload from RegionFile::Read for this chunk, decoded by Generate. Call before handing the chunk to a worker.
+	void SetSaved(std::vector<uint8_t>&& payload)
+	{
+		saved = std::move(payload);
+	}
+
+	// A copy of this chunk's edits for decoration to apply. Takes the ones applied already back out, the chunk has to go
+	// through decoration and everything after it again then. Never while a worker has the chunk.
+	void SetEdits(const EditLayer& edits)
+	{
+		if (decorated && this->edits.AddTo(heightfield, -1.0f))
+			heightfield.RecalculateNormals();
+
+		decorated = false;
+		this->edits = edits;
+	}
+
+	// Writes layer, this chunk's edits, to local x, z of region, with the procedural heights when CHUNK_CACHE_HEIGHTS
+	// caches them. Only level 0 heights are saved, a coarser level would lose the samples between its own, so saving a
+	// coarser chunk drops a cached copy. Main thread only.
+	bool Save(RegionFile& region, int x, int z, EditLayer* layer)
+	{
+		std::vector<uint8_t> payload;
+
+		if (layer && !layer->IsEmpty())
+			RegionFile::AppendSection(payload, RegionSection::EDITS, RegionCompression::TILE_RLE, RegionFile::EncodeEdits(*layer, CHUNK_HEIGHT_QUANTUM));
+
+		if (CHUNK_CACHE_HEIGHTS && level == 0)
+		{
+			Heightfield base = heightfield;
+
+			if (layer)
+				layer->AddTo(base, -1.0f);
+
+			RegionFile::AppendSection(payload, RegionSection::HEIGHTS, RegionCompression::PLANAR_VARINT, RegionFile::EncodeHeights(base, CHUNK_HEIGHT_QUANTUM));
+		}
+
+		if (!region.Write(x, z, payload))
+			return false;
+
+		modified = false;
+
+		if (layer)
+			layer->modified = false;
+
+		return true;
+	}
+
+	// Whether the procedural heights still have to go to CHUNK_CACHE_HEIGHTS's cache.
+	bool IsModified() const
+	{
+		return modified;
+	}
+
+	static EditLayer RegisterEdits(const glm::ivec3& position)
+	{
+		return EditLayer::Register({ position.x, position.z }, 1.0f / CHUNK_RESOLUTION, CHUNK_SIZE * CHUNK_RESOLUTION + 1, CHUNK_EDIT_APRON);
+	}
+
+	uint32_t GetSeed() const
+	{
+		return noise->GetSeed();
+	}
+
+	void SetTerrainProgram(const NoiseProgram* program)
+	{
+		this->program = program;
+	}
+
+	// Noise tier a chunk at level gets. Level 0 is always FULL, it's the only level that erodes and gets saved, coarser
+	// levels take the cheapest tier whose error stays within CHUNK_QUALITY_PIXELS on screen.
+	NoiseQuality SelectQuality(int level) const
+	{
+		if (level <= 0)
+			return NoiseQuality::FULL;
+
+		const float maxError = GetLod().GetScreenError(level, CHUNK_QUALITY_PIXELS, CHUNK_QUALITY_SCREEN_HEIGHT, glm::radians(CHUNK_QUALITY_FOV));
+
+		return noise->SelectQuality(CHUNK_SIZE * 4, 1.0f / (CHUNK_RESOLUTION >> level), maxError / scale);
+	}
+
+	NoiseQuality GetQuality() const
+	{
+		return quality;
+	}
+
+	// Switches between vertex buffers and a heightmap texture, takes effect on the next Rebuild.
+	void SetDisplacement(bool enabled)
 	{
-		float height00 = GetHeight(position.x, position.z);
-		float height01 = GetHeight(position.x, position.z + 0.125f);
-		float height10 = GetHeight(position.x + 0.125f, position.z);
-		float height11 = GetHeight(position.x + 0.125f, position.z + 0.125f);
+		displacement = enabled;
+	}
 
-		glm::vec3 normal = CalculateNormal(position.x, position.z);
+	// Generates from FixedNoise instead, so every client derives the same terrain from the seed alone. Erosion runs in float and is skipped.
+	void SetFixedPoint(bool enabled)
+	{
+		delete fixedNoise;
 
-		data.vertices.push_back(Vertex::Register({ position.x, height00, position.z }, normal, DEFAULT_COLOR, { 0.0f, 0.0f }));
-		data.vertices.push_back(Vertex::Register({ position.x, height01, position.z + 0.125f }, normal, DEFAULT_COLOR, { 0.0f, 1.0f }));
-		data.vertices.push_back(Vertex::Register({ position.x + 0.125f, height11, position.z + 0.125f }, normal, DEFAULT_COLOR, { 1.0f, 1.0f }));
-		data.vertices.push_back(Vertex::Register({ position.x + 0.125f, height10, position.z }, normal, DEFAULT_COLOR, { 1.0f, 0.0f }));
+		fixedNoise = enabled ? new FixedNoise(*noise) : nullptr;
+	}
 
-		data.indices.push_back(data.indiceIndex);
-		data.indices.push_back(1 + data.indiceIndex);
-		data.indices.push_back(3 + data.indiceIndex);
+	void SetErosion(const HydraulicErosion& erosion)
+	{
+		this->erosion = erosion;
 
-		data.indices.push_back(3 + data.indiceIndex);
-		data.indices.push_back(1 + data.indiceIndex);
-		data.indices.push_back(2 + data.indiceIndex);
+		if (level == 0 && heightfield.apron != 1 + erosion.GetHalo())
+			heightfield = Heightfield::Register(heightfield.origin, heightfield.step, heightfield.resolution, 1 + erosion.GetHalo());
+	}
 
-		data.indiceIndex += 4;
+	int GetLevel() const
+	{
+		return level;
+	}
+
+	size_t GetTriangleCount() const
+	{
+		size_t out = 0;
+
+		DispatchLevel([&](auto mesher) { out = decltype(mesher)::TriangleCount; });
+
+		return out;
+	}
+
+	static const TerrainLod& GetLod()
+	{
+		static const TerrainLod lod = TerrainLod::Register(CHUNK_SIZE, CHUNK_LOD_DISTANCE, CHUNK_LOD_LEVELS);
+
+		return lod;
+	}
+
+	float GetHeightAt(float x, float z) const
+	{
+		return heightfield.Sample(x - heightfield.origin.x, z - heightfield.origin.y);
 	}
 
 	void CleanUp()
 	{
+		if (data.object)
+		{
+			Renderer::UnregisterRenderableObject(data.object);
+			data.object->CleanUp();
+		}
+
 		delete noise;
+		delete fixedNoise;
 
 		delete this;
 	}
 
 	ChunkData data;
+	Heightfield heightfield;
+	BiomeTile biomes;
 
 private:
 
-	glm::vec3 CalculateNormal(float x, float z)
+	bool LoadSaved()
+	{
+		RegionCompression compression = RegionCompression::NONE;
+		const uint8_t* section = nullptr;
+		size_t length = 0;
+
+		const bool loaded = RegionFile::FindSection(saved, RegionSection::HEIGHTS, compression, section, length) && compression == RegionCompression::PLANAR_VARINT && RegionFile::DecodeHeights(section, length, heightfield);
+
+		saved.clear();
+		saved.shrink_to_fit();
+
+		// The analytic normals from generation aren't saved, differences across the heights come close enough.
+		if (loaded)
+			heightfield.RecalculateNormals();
+
+		return loaded;
+	}
+
+	float GetSkirtDepth() const
+	{
+		return CHUNK_SKIRT_DEPTH * static_cast<float>(1 << level);
+	}
+
+	// Every chunk of a level draws with the same program for type, the uniforms only depend on the level so they're set once
+	// when it's compiled.
+	ShaderObject GetProgram(ShaderType type) const
+	{
+		bool created = false;
+		ShaderObject program = ShaderManager::GetGeneratedShader("Chunk(" + std::to_string(static_cast<int>(type)) + ", " + std::to_string(level) + ")", type, &created);
+
+		if (created)
+		{
+			program.Use();
+			program.SetUniform("morphRange", GetLod().GetMorphRange(level));
+			program.SetUniform("gridCells", CHUNK_SIZE * (CHUNK_RESOLUTION >> level));
+			program.SetUniform("gridStep", 1.0f / (CHUNK_RESOLUTION >> level));
+			program.SetUniform("skirtDepth", GetSkirtDepth());
+			program.SetUniform("heightQuantum", CHUNK_HEIGHT_QUANTUM);
+			program.SetUniform("heightmap", CHUNK_HEIGHTMAP_UNIT);
+		}
+
+		return program;
+	}
+
+	// The heightmap texture belongs to this chunk, unlike the shared ones from TextureManager.
+	void CleanUpHeightmap()
 	{
-		glm::vec3 tangentX = glm::vec3(0.125f, GetHeight(x + 0.125f, z) - GetHeight(x, z), 0.0f);
-		glm::vec3 tangentZ = glm::vec3(0.0f, GetHeight(x, z + 0.125f) - GetHeight(x, z), 0.125f);
+		auto iterator = data.object->data.textures.find("heightmap");
 
-		glm::vec3 normal = glm::normalize(glm::cross(tangentX, tangentZ));
+		if (iterator == data.object->data.textures.end())
+			return;
 
-		return normal;
+		iterator->second.CleanUp();
+		data.object->data.textures.erase(iterator);
 	}
 
-	float GetHeight(float x, float z)
+	// Calls function with the TerrainMesher for this chunk's level.
+	template<typename Function>
+	void DispatchLevel(Function&& function) const
 	{
-		return noise->FractalNoise(CHUNK_SIZE * 4, x, z) * scale + offset;
+		switch (level)
+		{
+		case 0: function(TerrainMesher<CHUNK_SIZE, CHUNK_RESOLUTION>()); break;
+		case 1: function(TerrainMesher<CHUNK_SIZE, CHUNK_RESOLUTION / 2>()); break;
+		case 2: function(TerrainMesher<CHUNK_SIZE, CHUNK_RESOLUTION / 4>()); break;
+		default: function(TerrainMesher<CHUNK_SIZE, CHUNK_RESOLUTION / 8>()); break;
+		}
 	}
 
+	glm::ivec3 position = { 0, 0, 0 };
+	int level = 0;
+	bool displacement = CHUNK_GPU_DISPLACEMENT;
+	bool modified = false;
+	bool generated = false;
+	bool decorated = false;
+	std::vector<uint8_t> saved = {};
+	EditLayer edits = {};
 	Noise* noise = nullptr;
+	FixedNoise* fixedNoise = nullptr;
+	const NoiseProgram* program = nullptr;
+	BiomeMap biomeMap = BiomeMap::Register(0.02f, 0.2f);
+	HydraulicErosion erosion = {};
+	NoiseQuality quality = NoiseQuality::FULL;
 	float scale = 1.0f;
 	float offset = 0.0f;
 
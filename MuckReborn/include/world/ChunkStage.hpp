@@ -0,0 +1,98 @@
+#ifndef CHUNK_STAGE_HPP
+#define CHUNK_STAGE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Steps a chunk goes through in order, each one run exactly once unless the chunk's edits change. A chunk at a stage has
+// finished that stage, NONE hasn't started.
+enum class ChunkStage : uint8_t
+{
+	NONE,
+	HEIGHT,
+	BIOME,
+	EROSION,
+	DECORATION,
+	MESH,
+	UPLOAD
+};
+
+#define CHUNK_STAGE_COUNT 7
+
+namespace ChunkStages
+{
+	ChunkStage GetNext(ChunkStage stage)
+	{
+		return stage == ChunkStage::UPLOAD ? ChunkStage::UPLOAD : static_cast<ChunkStage>(static_cast<uint8_t>(stage) + 1);
+	}
+
+	// Stage the neighbours at -x, +x, -z and +z have to reach before a chunk starts stage, NONE when it doesn't read them.
+	// Meshing copies the border samples the neighbours own, which are only final once their edits are in.
+	ChunkStage GetRequirement(ChunkStage stage)
+	{
+		return stage == ChunkStage::MESH ? ChunkStage::DECORATION : ChunkStage::NONE;
+	}
+
+	const char* GetName(ChunkStage stage)
+	{
+		switch (stage)
+		{
+		case ChunkStage::HEIGHT: return "height";
+		case ChunkStage::BIOME: return "biome";
+		case ChunkStage::EROSION: return "erosion";
+		case ChunkStage::DECORATION: return "decoration";
+		case ChunkStage::MESH: return "mesh";
+		case ChunkStage::UPLOAD: return "upload";
+		default: return "none";
+		}
+	}
+}
+
+// Time spent in each stage summed over every chunk, recorded into from any thread.
+class ChunkStageTimer
+{
+
+public:
+
+	void Record(ChunkStage stage, std::chrono::steady_clock::duration duration)
+	{
+		nanoseconds[static_cast<size_t>(stage)] += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+		counts[static_cast<size_t>(stage)]++;
+	}
+
+	uint64_t GetCount(ChunkStage stage) const
+	{
+		return counts[static_cast<size_t>(stage)];
+	}
+
+	double GetTotalMilliseconds(ChunkStage stage) const
+	{
+		return nanoseconds[static_cast<size_t>(stage)] / 1.0e6;
+	}
+
+	double GetAverageMilliseconds(ChunkStage stage) const
+	{
+		const uint64_t count = GetCount(stage);
+
+		return count > 0 ? GetTotalMilliseconds(stage) / count : 0.0;
+	}
+
+	void Reset()
+	{
+		for (size_t i = 0; i < CHUNK_STAGE_COUNT; i++)
+		{
+			nanoseconds[i] = 0;
+			counts[i] = 0;
+		}
+	}
+
+private:
+
+	std::array<std::atomic<uint64_t>, CHUNK_STAGE_COUNT> nanoseconds = {};
+	std::array<std::atomic<uint64_t>, CHUNK_STAGE_COUNT> counts = {};
+
+};
+
+#endif // !CHUNK_STAGE_HPP
\ No newline at end of file
@@ -0,0 +1,161 @@
+#ifndef DENSITY_CHUNK_HPP
+#define DENSITY_CHUNK_HPP
+
+#include <string>
+#include <vector>
+#include "core/ThreadPool.hpp"
+#include "math/Noise.hpp"
+#include "rendering/Renderer.hpp"
+#include "util/General.hpp"
+#include "world/Block.hpp"
+#include "world/Chunk.hpp"
+#include "world/DensityField.hpp"
+#include "world/SurfaceNets.hpp"
+
+// Cells per world unit, and fine cells per noise sample on each axis. Two octaves of Noise(0.45, 10) fit under the
+// Nyquist limit of the coarse grid this gives, the rest would only alias.
+#define DENSITY_RESOLUTION 4
+#define DENSITY_COARSE_FACTOR 2
+
+// The noise is worth DENSITY_AMPLITUDE units of height, so the ground is hollowed out over DENSITY_AMPLITUDE /
+// DENSITY_FALLOFF units above and below the offset and solid or empty past that.
+#define DENSITY_AMPLITUDE 1.5f
+#define DENSITY_FALLOFF 0.5f
+
+// Up component of the normal below which the ground is bare stone instead of grass.
+#define DENSITY_GRASS_SLOPE 0.6f
+
+static_assert((CHUNK_SIZE * DENSITY_RESOLUTION) % DENSITY_COARSE_FACTOR == 0, "the coarse grid has to line up with the chunk edges");
+
+struct DensityChunkData : IPackagable
+{
+	RenderableObject* object = 0;
+
+	std::vector<Vertex> vertices = {};
+	std::vector<unsigned int> indices = {};
+};
+
+// A CHUNK_SIZE cube of volumetric terrain, caves and overhangs included, meshed out of a DensityField with SurfaceNets and
+// drawn through the plain Vertex path of RenderableObject. Stacks with the chunks above and below it.
+class DensityChunk : IPackagable
+{
+
+public:
+
+	void InitalizeChunk(const glm::ivec3& position)
+	{
+		Prepare(position);
+		Rebuild();
+	}
+
+	// position is in world units, a multiple of CHUNK_SIZE on every axis. Nothing here touches GL.
+	void Prepare(const glm::ivec3& position, float offset = 0.0f)
+	{
+		this->position = position;
+		this->offset = offset;
+		noise = new Noise(0.45, 10);
+		field = DensityField::Register(glm::vec3(position), 1.0f / DENSITY_RESOLUTION, CHUNK_SIZE * DENSITY_RESOLUTION, DENSITY_COARSE_FACTOR);
+	}
+
+	void Rebuild()
+	{
+		Generate();
+		Upload();
+	}
+
+	// Samples the field and meshes it. Only touches this chunk's own data, safe to call from a worker thread.
+	void Generate()
+	{
+		std::vector<SurfaceVertex> surface;
+
+		field.Generate(*noise, CHUNK_SIZE * 4, DENSITY_AMPLITUDE, DENSITY_FALLOFF, offset);
+		SurfaceNets::Generate(field, surface, data.indices);
+		triangles = data.indices.size() / 3;
+
+		data.vertices.clear();
+		data.vertices.reserve(surface.size());
+
+		for (const SurfaceVertex& vertex : surface)
+		{
+			const glm::vec3 color = Block::GetColor(vertex.normal.y > DENSITY_GRASS_SLOPE ? BlockType::GRASS : BlockType::STONE);
+			const glm::vec3 absolute = glm::abs(vertex.normal);
+
+			// Projected along the axis the surface faces most, so walls don't get the floor's stretched texture.
+			glm::vec2 textureCoordinates = { vertex.position.x, vertex.position.z };
+
+			if (absolute.x > absolute.y && absolute.x > absolute.z)
+				textureCoordinates = { vertex.position.z, vertex.position.y };
+			else if (absolute.z > absolute.y)
+				textureCoordinates = { vertex.position.x, vertex.position.y };
+
+			data.vertices.push_back(Vertex::Register(vertex.position, color, vertex.normal, textureCoordinates));
+		}
+	}
+
+	// Main thread only, replaces the renderable object with one holding the mesh from Generate.
+	void Upload()
+	{
+		if (data.object)
+		{
+			Renderer::UnregisterRenderableObject(data.object);
+			data.object->CleanUp();
+			data.object = nullptr;
+		}
+
+		if (data.indices.empty())
+			return;
+
+		data.object = RenderableObject::Register("DensityChunk(" + std::to_string(position.x) + ", " + std::to_string(position.y) + ", " + std::to_string(position.z) + ")", data.vertices, data.indices, false, false, ShaderManager::GetGeneratedShader("voxel", ShaderType::VOXEL));
+		data.object->data.shaders["shadow"] = ShaderManager::GetGeneratedShader("shadow", ShaderType::SHADOW);
+		data.object->data.transform.position = position;
+		data.object->RegisterTexture(TextureManager::GetGeneratedTexture("test_texture"));
+		data.object->GenerateRawData();
+
+		// RenderableObject keeps its own copy.
+		data.vertices = {};
+		data.indices = {};
+
+		Renderer::RegisterRenderableObject(data.object);
+	}
+
+	size_t GetTriangleCount() const
+	{
+		return triangles;
+	}
+
+	void CleanUp()
+	{
+		if (data.object)
+		{
+			Renderer::UnregisterRenderableObject(data.object);
+			data.object->CleanUp();
+		}
+
+		delete noise;
+
+		delete this;
+	}
+
+	// Generates every chunk across the pool, one chunk per task, then uploads them in order on the calling thread, which
+	// has to be the main thread.
+	static void GenerateAll(const std::vector<DensityChunk*>& chunks, ThreadPool& pool)
+	{
+		pool.ParallelFor(chunks.size(), [&](size_t index) { chunks[index]->Generate(); });
+
+		for (DensityChunk* chunk : chunks)
+			chunk->Upload();
+	}
+
+	DensityChunkData data;
+	DensityField field;
+
+private:
+
+	glm::ivec3 position = { 0, 0, 0 };
+	float offset = 0.0f;
+	size_t triangles = 0;
+	Noise* noise = nullptr;
+
+};
+
+#endif // !DENSITY_CHUNK_HPP
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef DENSITY_FIELD_HPP
+#define DENSITY_FIELD_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <glm/glm.hpp>
+#include "math/Noise.hpp"
+
+// Solid where positive. A cube of cells^3 cells, step apart, sampled at every corner plus one sample past each face so
+// the cells on a neighbour's side of the border can be meshed too.
+struct DensityField
+{
+	glm::vec3 origin = { 0.0f, 0.0f, 0.0f };
+	float step = 0.25f;
+	int cells = 0;
+
+	// Cells per coarse cell, the noise is only evaluated every factor samples and trilinearly upsampled between them.
+	int factor = 1;
+
+	// (cells + 3)^3 samples, from -1 to cells + 1 on every axis.
+	std::vector<float> values = {};
+
+	// 3D noise pulled down with height, so falloff * height has to outweigh amplitude for the ground to close up. Where
+	// it doesn't the noise carves caves and overhangs. Octaves the coarse grid can't resolve are left out rather than
+	// aliased, only the linear height term is exact between coarse samples. cells has to be a multiple of factor.
+	void Generate(const Noise& noise, size_t octaves, float amplitude, float falloff, float offset)
+	{
+		const int coarseStride = GetCoarseStride();
+		const size_t coarseCount = static_cast<size_t>(coarseStride) * coarseStride * coarseStride;
+		const float coarseStep = step * factor;
+
+		std::vector<float> xs(coarseCount), ys(coarseCount), zs(coarseCount), coarse(coarseCount);
+
+		for (int z = 0; z < coarseStride; z++)
+		{
+			for (int y = 0; y < coarseStride; y++)
+			{
+				for (int x = 0; x < coarseStride; x++)
+				{
+					const size_t index = (static_cast<size_t>(z) * coarseStride + y) * coarseStride + x;
+
+					xs[index] = origin.x + (x - 1) * coarseStep;
+					ys[index] = origin.y + (y - 1) * coarseStep;
+					zs[index] = origin.z + (z - 1) * coarseStep;
+				}
+			}
+		}
+
+		const size_t resolved = noise.GetReducedOctaves(octaves, coarseStep);
+
+		// With none resolved the noise is left at its mean of 0.
+		if (resolved > 0)
+			noise.FractalNoise3D(resolved, xs.data(), ys.data(), zs.data(), coarse.data(), coarseCount);
+
+		for (size_t i = 0; i < coarseCount; i++)
+			coarse[i] = coarse[i] * amplitude - (ys[i] - offset) * falloff;
+
+		auto Coarse = [&](int x, int y, int z) { return coarse[(static_cast<size_t>(z) * coarseStride + y) * coarseStride + x]; };
+
+		// Sample i of the fine grid lies at coarse coordinate (i - 1 + factor) / factor, both counted from their first apron sample.
+		std::vector<int> cell(GetStride());
+		std::vector<float> weight(GetStride());
+
+		for (int i = 0; i < GetStride(); i++)
+		{
+			const int shifted = i - 1 + factor;
+
+			cell[i] = std::min(shifted / factor, coarseStride - 2);
+			weight[i] = static_cast<float>(shifted - cell[i] * factor) / factor;
+		}
+
+		for (int z = 0; z < GetStride(); z++)
+		{
+			for (int y = 0; y < GetStride(); y++)
+			{
+				for (int x = 0; x < GetStride(); x++)
+				{
+					const int cx = cell[x], cy = cell[y], cz = cell[z];
+					const float tx = weight[x], ty = weight[y], tz = weight[z];
+
+					const float bottom = glm::mix(glm::mix(Coarse(cx, cy, cz), Coarse(cx + 1, cy, cz), tx), glm::mix(Coarse(cx, cy + 1, cz), Coarse(cx + 1, cy + 1, cz), tx), ty);
+					const float top = glm::mix(glm::mix(Coarse(cx, cy, cz + 1), Coarse(cx + 1, cy, cz + 1), tx), glm::mix(Coarse(cx, cy + 1, cz + 1), Coarse(cx + 1, cy + 1, cz + 1), tx), ty);
+
+					values[(static_cast<size_t>(z) * GetStride() + y) * GetStride() + x] = glm::mix(bottom, top, tz);
+				}
+			}
+		}
+	}
+
+	int GetStride() const
+	{
+		return cells + 3;
+	}
+
+	// Coarse samples per side, from one coarse cell before the origin to one past the far corner.
+	int GetCoarseStride() const
+	{
+		return cells / factor + 3;
+	}
+
+	size_t GetIndex(int x, int y, int z) const
+	{
+		return (static_cast<size_t>(z + 1) * GetStride() + (y + 1)) * GetStride() + (x + 1);
+	}
+
+	float Get(int x, int y, int z) const
+	{
+		return values[GetIndex(x, y, z)];
+	}
+
+	static DensityField Register(const glm::vec3& origin, float step, int cells, int factor = 1)
+	{
+		DensityField out = {};
+
+		out.origin = origin;
+		out.step = step;
+		out.cells = cells;
+		out.factor = factor;
+		out.values.resize(static_cast<size_t>(out.GetStride()) * out.GetStride() * out.GetStride());
+
+		return out;
+	}
+};
+
+#endif // !DENSITY_FIELD_HPP
\ No newline at end of file
@@ -0,0 +1,204 @@
+#ifndef EDIT_LAYER_HPP
+#define EDIT_LAYER_HPP
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <glm/glm.hpp>
+#include "world/Heightfield.hpp"
+#include "world/TerrainBrush.hpp"
+
+#define EDIT_TILE_SIZE 8
+
+// Player edits to one chunk as height differences from its procedural base, on the finest grid. Differences live in
+// tiles of EDIT_TILE_SIZE^2 samples that only exist once something inside them changed, so an untouched chunk costs
+// nothing. A chunk at any level is rebuilt as its base plus the differences under its samples.
+struct EditLayer
+{
+	using Tile = std::array<float, EDIT_TILE_SIZE * EDIT_TILE_SIZE>;
+
+	glm::vec2 origin = { 0.0f, 0.0f };
+	float step = 0.125f;
+	int resolution = 0;
+
+	// Samples past each side the edits reach, enough for the apron of the coarsest level.
+	int apron = 0;
+
+	// Keyed by GetTileIndex, ordered so a layer always encodes the same way.
+	std::map<uint16_t, Tile> tiles = {};
+
+	// Bumped by every change, a chunk generated from an older copy is out of date.
+	uint32_t revision = 0;
+
+	// Changed since it was last saved.
+	bool modified = false;
+
+	bool IsEmpty() const
+	{
+		return tiles.empty();
+	}
+
+	int GetStride() const
+	{
+		return resolution + 2 * apron;
+	}
+
+	int GetTilesPerSide() const
+	{
+		return (GetStride() + EDIT_TILE_SIZE - 1) / EDIT_TILE_SIZE;
+	}
+
+	uint16_t GetTileIndex(int x, int z) const
+	{
+		return static_cast<uint16_t>(((z + apron) / EDIT_TILE_SIZE) * GetTilesPerSide() + (x + apron) / EDIT_TILE_SIZE);
+	}
+
+	size_t GetTileOffset(int x, int z) const
+	{
+		return static_cast<size_t>((z + apron) % EDIT_TILE_SIZE) * EDIT_TILE_SIZE + (x + apron) % EDIT_TILE_SIZE;
+	}
+
+	bool Contains(int x, int z) const
+	{
+		return x >= -apron && z >= -apron && x < resolution + apron && z < resolution + apron;
+	}
+
+	float Get(int x, int z) const
+	{
+		if (!Contains(x, z))
+			return 0.0f;
+
+		auto iterator = tiles.find(GetTileIndex(x, z));
+
+		return iterator == tiles.end() ? 0.0f : iterator->second[GetTileOffset(x, z)];
+	}
+
+	// Creates the tile holding x, z the first time it's written.
+	float& At(int x, int z)
+	{
+		auto iterator = tiles.find(GetTileIndex(x, z));
+
+		if (iterator == tiles.end())
+		{
+			iterator = tiles.emplace(GetTileIndex(x, z), Tile{}).first;
+			iterator->second.fill(0.0f);
+		}
+
+		return iterator->second[GetTileOffset(x, z)];
+	}
+
+	// Adds scale times the differences to the samples of heightfield they lie under, which may be at a coarser level over
+	// the same origin. Returns whether heightfield changed.
+	bool AddTo(Heightfield& heightfield, float scale = 1.0f) const
+	{
+		const int factor = static_cast<int>(std::lround(heightfield.step / step));
+
+		if (tiles.empty() || factor < 1 || heightfield.origin != origin)
+			return false;
+
+		const int tilesPerSide = GetTilesPerSide();
+		bool out = false;
+
+		for (const auto& [index, tile] : tiles)
+		{
+			const int firstX = (index % tilesPerSide) * EDIT_TILE_SIZE - apron;
+			const int firstZ = (index / tilesPerSide) * EDIT_TILE_SIZE - apron;
+
+			for (int z = firstZ; z < firstZ + EDIT_TILE_SIZE; z++)
+			{
+				for (int x = firstX; x < firstX + EDIT_TILE_SIZE; x++)
+				{
+					const float difference = tile[GetTileOffset(x, z)];
+
+					if (difference == 0.0f || x % factor != 0 || z % factor != 0)
+						continue;
+
+					const int targetX = x / factor;
+					const int targetZ = z / factor;
+
+					if (targetX < -heightfield.apron || targetZ < -heightfield.apron || targetX >= heightfield.resolution + heightfield.apron || targetZ >= heightfield.resolution + heightfield.apron)
+						continue;
+
+					heightfield.At(targetX, targetZ) += difference * scale;
+					out = true;
+				}
+			}
+		}
+
+		return out;
+	}
+
+	// Applies brush to the differences and the same change to heightfield, this layer's chunk at the finest level. A
+	// coarser level only has interpolated heights to measure the brush against, which would save the wrong differences
+	// for FLATTEN, so it's left untouched. Returns heightfield's changed samples as (x0, z0, x1, z1) inclusive, x1 < x0
+	// when nothing changed.
+	glm::ivec4 Apply(const TerrainBrush& brush, const glm::vec2& center, float deltaTime, Heightfield& heightfield)
+	{
+		const glm::vec2 local = (center - origin) / step;
+		const float reach = brush.radius / step;
+		const int first = -apron;
+		const int last = resolution + apron - 1;
+
+		const glm::ivec4 bounds = { std::max(first, static_cast<int>(std::ceil(local.x - reach))), std::max(first, static_cast<int>(std::ceil(local.y - reach))), std::min(last, static_cast<int>(std::floor(local.x + reach))), std::min(last, static_cast<int>(std::floor(local.y + reach))) };
+		glm::ivec4 out = { INT_MAX, INT_MAX, INT_MIN, INT_MIN };
+		bool changed = false;
+
+		if (std::lround(heightfield.step / step) != 1 || heightfield.origin != origin)
+			return out;
+
+		for (int z = bounds.y; z <= bounds.w; z++)
+		{
+			for (int x = bounds.x; x <= bounds.z; x++)
+			{
+				const glm::vec2 position = glm::vec2{ static_cast<float>(x), static_cast<float>(z) } * step;
+				const float weight = brush.GetWeight(glm::length(origin + position - center));
+
+				if (weight <= 0.0f)
+					continue;
+
+				if (x < -heightfield.apron || z < -heightfield.apron || x >= heightfield.resolution + heightfield.apron || z >= heightfield.resolution + heightfield.apron)
+					continue;
+
+				const float height = heightfield.Get(x, z);
+				const float change = brush.Apply(height, weight, deltaTime) - height;
+
+				if (change == 0.0f)
+					continue;
+
+				At(x, z) += change;
+				changed = true;
+
+				heightfield.At(x, z) += change;
+				out = { std::min(out.x, x), std::min(out.y, z), std::max(out.z, x), std::max(out.w, z) };
+			}
+		}
+
+		if (changed)
+		{
+			revision++;
+			modified = true;
+		}
+
+		if (out.z >= out.x)
+			heightfield.RecalculateNormals(out + glm::ivec4{ -1, -1, 1, 1 });
+
+		return out;
+	}
+
+	static EditLayer Register(const glm::vec2& origin, float step, int resolution, int apron)
+	{
+		EditLayer out = {};
+
+		out.origin = origin;
+		out.step = step;
+		out.resolution = resolution;
+		out.apron = apron;
+
+		return out;
+	}
+};
+
+#endif // !EDIT_LAYER_HPP
\ No newline at end of file
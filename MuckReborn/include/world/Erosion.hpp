@@ -0,0 +1,273 @@
+#ifndef EROSION_HPP
+#define EROSION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/ThreadPool.hpp"
+#include "world/Heightfield.hpp"
+
+// Particle based hydraulic erosion over a Heightfield's interior and apron.
+// Droplets are spawned from a hash of world sample coordinates and grouped into world aligned cells. The droplets of a
+// cell run one after another on their own copy of the generated heights around it, and the cells' changes are summed in
+// world order. A sample then only depends on the cells within reach of it, which a neighbouring tile with the same apron
+// simulates bit for bit the same way, so the eroded heights agree up to and across every shared edge.
+struct HydraulicErosion
+{
+	// Droplet budget for the tile's interior, the apron is seeded at the same density.
+	int iterations = 4096;
+
+	// Also the distance in samples a droplet can travel, which sets the apron (see GetHalo).
+	int maxLifetime = 16;
+
+	// Side in samples of the cells whose droplets see each other's changes. Larger cells carve deeper shared channels but
+	// widen the apron by as much.
+	int cellSize = 16;
+
+	uint32_t seed = 0;
+
+	float inertia = 0.05f;
+	float capacity = 4.0f;
+	float minCapacity = 0.01f;
+	float depositSpeed = 0.3f;
+	float erodeSpeed = 0.3f;
+	float evaporateSpeed = 0.02f;
+	float gravity = 4.0f;
+
+	// tile.apron has to be at least 1 + GetHalo().
+	void Erode(Heightfield& tile) const
+	{
+		if (iterations <= 0)
+			return;
+
+		const int stride = tile.GetStride();
+		const int size = glm::max(cellSize, 1);
+		const int reach = GetReach();
+		const int64_t firstX = static_cast<int64_t>(std::floor(tile.origin.x / tile.step + 0.5f)) - tile.apron;
+		const int64_t firstZ = static_cast<int64_t>(std::floor(tile.origin.y / tile.step + 0.5f)) - tile.apron;
+
+		// Heights are simulated in sample units so the parameters don't depend on the tile's step.
+		std::vector<float> map(tile.heights.size());
+		std::vector<float> change(map.size(), 0.0f);
+
+		for (size_t i = 0; i < map.size(); i++)
+			map[i] = tile.heights[i] / tile.step;
+
+		const float density = static_cast<float>(iterations) / (static_cast<float>(tile.resolution) * tile.resolution);
+		const int whole = static_cast<int>(density);
+		const uint32_t fraction = static_cast<uint32_t>((density - whole) * 4294967295.0);
+
+		// Cells holding a droplet start that can reach the interior or the ring around it, which the border normals read.
+		const int64_t firstCellX = FloorDivide(firstX + tile.apron - 1 - reach, size);
+		const int64_t firstCellZ = FloorDivide(firstZ + tile.apron - 1 - reach, size);
+		const int64_t lastCellX = FloorDivide(firstX + tile.apron + tile.resolution + maxLifetime, size);
+		const int64_t lastCellZ = FloorDivide(firstZ + tile.apron + tile.resolution + maxLifetime, size);
+
+		const int width = size + 2 * reach;
+		std::vector<float> cell(static_cast<size_t>(width) * width);
+
+		for (int64_t cellZ = firstCellZ; cellZ <= lastCellZ; cellZ++)
+		{
+			for (int64_t cellX = firstCellX; cellX <= lastCellX; cellX++)
+			{
+				// Corner of the cell's copy in the tile's samples, reach out from the cell.
+				const int left = static_cast<int>(cellX * size - firstX) - reach;
+				const int top = static_cast<int>(cellZ * size - firstZ) - reach;
+
+				if (left < 0 || top < 0 || left + width > stride || top + width > stride)
+					continue;
+
+				for (int z = 0; z < width; z++)
+					std::copy_n(map.data() + static_cast<size_t>(top + z) * stride + left, width, cell.data() + static_cast<size_t>(z) * width);
+
+				for (int z = reach; z < reach + size; z++)
+				{
+					for (int x = reach; x < reach + size; x++)
+					{
+						uint32_t state = Hash(static_cast<uint32_t>(firstX + left + x), static_cast<uint32_t>(firstZ + top + z), seed);
+						const int count = whole + (Next(state) < fraction ? 1 : 0);
+
+						for (int i = 0; i < count; i++)
+						{
+							const float offsetX = (Next(state) >> 8) * (1.0f / 16777216.0f);
+							const float offsetZ = (Next(state) >> 8) * (1.0f / 16777216.0f);
+
+							SimulateDroplet(cell.data(), width, x, z, offsetX, offsetZ);
+						}
+					}
+				}
+
+				for (int z = 0; z < width; z++)
+				{
+					for (int x = 0; x < width; x++)
+					{
+						const size_t index = static_cast<size_t>(top + z) * stride + left + x;
+
+						change[index] += cell[static_cast<size_t>(z) * width + x] - map[index];
+					}
+				}
+			}
+		}
+
+		for (size_t i = 0; i < tile.heights.size(); i++)
+			tile.heights[i] += change[i] * tile.step;
+
+		tile.RecalculateNormals();
+	}
+
+	// Tiles are independent of each other, so the result doesn't depend on the thread count.
+	void Erode(Heightfield* tiles, size_t count, ThreadPool& pool) const
+	{
+		pool.ParallelFor(count, [&](size_t index) { Erode(tiles[index]); });
+	}
+
+	void Erode(std::vector<Heightfield>& tiles, ThreadPool& pool) const
+	{
+		Erode(tiles.data(), tiles.size(), pool);
+	}
+
+	// Apron past the ring around the interior: a cell can start up to its side minus one before the first droplet start
+	// that reaches the ring, and its copy extends a reach out from both.
+	int GetHalo() const
+	{
+		return 2 * GetReach() + glm::max(cellSize, 1) - 1;
+	}
+
+	static HydraulicErosion Register(int iterations, uint32_t seed)
+	{
+		HydraulicErosion out = {};
+
+		out.iterations = iterations;
+		out.seed = seed;
+
+		return out;
+	}
+
+private:
+
+	// Samples a droplet can touch on either side of the cell it starts in: one per step and one for the bilinear footprint.
+	int GetReach() const
+	{
+		return glm::max(maxLifetime, 0) + 1;
+	}
+
+	// Positions are kept relative to the start cell, so the rounding doesn't depend on where the tile is.
+	void SimulateDroplet(float* map, int stride, int startX, int startZ, float positionX, float positionZ) const
+	{
+		float directionX = 0.0f;
+		float directionZ = 0.0f;
+		float speed = 1.0f;
+		float water = 1.0f;
+		float sediment = 0.0f;
+
+		for (int lifetime = 0; lifetime < maxLifetime; lifetime++)
+		{
+			const int offsetX = static_cast<int>(std::floor(positionX));
+			const int offsetZ = static_cast<int>(std::floor(positionZ));
+			const int nodeX = startX + offsetX;
+			const int nodeZ = startZ + offsetZ;
+			const float cellX = positionX - offsetX;
+			const float cellZ = positionZ - offsetZ;
+
+			float gradientX = 0.0f;
+			float gradientZ = 0.0f;
+			const float height = SampleHeight(map, stride, nodeX, nodeZ, cellX, cellZ, gradientX, gradientZ);
+
+			directionX = directionX * inertia - gradientX * (1.0f - inertia);
+			directionZ = directionZ * inertia - gradientZ * (1.0f - inertia);
+
+			const float length = std::sqrt(directionX * directionX + directionZ * directionZ);
+
+			if (length <= 0.0f)
+				break;
+
+			directionX /= length;
+			directionZ /= length;
+			positionX += directionX;
+			positionZ += directionZ;
+
+			const int nextOffsetX = static_cast<int>(std::floor(positionX));
+			const int nextOffsetZ = static_cast<int>(std::floor(positionZ));
+			const int nextX = startX + nextOffsetX;
+			const int nextZ = startZ + nextOffsetZ;
+
+			if (nextX < 0 || nextZ < 0 || nextX >= stride - 1 || nextZ >= stride - 1)
+				break;
+
+			float unusedX = 0.0f;
+			float unusedZ = 0.0f;
+			const float deltaHeight = SampleHeight(map, stride, nextX, nextZ, positionX - nextOffsetX, positionZ - nextOffsetZ, unusedX, unusedZ) - height;
+
+			const float carry = glm::max(-deltaHeight * speed * water * capacity, minCapacity);
+
+			float* node = map + static_cast<size_t>(nodeZ) * stride + nodeX;
+			const float weights[4] = { (1.0f - cellX) * (1.0f - cellZ), cellX * (1.0f - cellZ), (1.0f - cellX) * cellZ, cellX * cellZ };
+			float* corners[4] = { node, node + 1, node + stride, node + stride + 1 };
+
+			if (sediment > carry || deltaHeight > 0.0f)
+			{
+				const float amount = deltaHeight > 0.0f ? glm::min(deltaHeight, sediment) : (sediment - carry) * depositSpeed;
+
+				sediment -= amount;
+
+				for (int i = 0; i < 4; i++)
+					*corners[i] += amount * weights[i];
+			}
+			else
+			{
+				const float amount = glm::min((carry - sediment) * erodeSpeed, -deltaHeight);
+
+				sediment += amount;
+
+				for (int i = 0; i < 4; i++)
+					*corners[i] -= amount * weights[i];
+			}
+
+			speed = std::sqrt(glm::max(speed * speed - deltaHeight * gravity, 0.0f));
+			water *= 1.0f - evaporateSpeed;
+		}
+	}
+
+	static int64_t FloorDivide(int64_t value, int64_t divisor)
+	{
+		return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+	}
+
+	static float SampleHeight(const float* map, int stride, int nodeX, int nodeZ, float cellX, float cellZ, float& gradientX, float& gradientZ)
+	{
+		const float* node = map + static_cast<size_t>(nodeZ) * stride + nodeX;
+		const float h00 = node[0];
+		const float h10 = node[1];
+		const float h01 = node[stride];
+		const float h11 = node[stride + 1];
+
+		gradientX = (h10 - h00) * (1.0f - cellZ) + (h11 - h01) * cellZ;
+		gradientZ = (h01 - h00) * (1.0f - cellX) + (h11 - h10) * cellX;
+
+		return h00 * (1.0f - cellX) * (1.0f - cellZ) + h10 * cellX * (1.0f - cellZ) + h01 * (1.0f - cellX) * cellZ + h11 * cellX * cellZ;
+	}
+
+	static uint32_t Hash(uint32_t x, uint32_t z, uint32_t seed)
+	{
+		uint32_t hash = seed * 0x9E3779B9u ^ x * 0x85EBCA6Bu ^ z * 0xC2B2AE35u;
+
+		hash ^= hash >> 16;
+		hash *= 0x7FEB352Du;
+		hash ^= hash >> 15;
+		hash *= 0x846CA68Bu;
+		hash ^= hash >> 16;
+
+		return hash;
+	}
+
+	static uint32_t Next(uint32_t& state)
+	{
+		state = state * 1664525u + 1013904223u;
+
+		return state ^ (state >> 16);
+	}
+};
+
+#endif // !EROSION_HPP
\ No newline at end of file
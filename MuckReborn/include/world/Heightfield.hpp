@@ -0,0 +1,143 @@
+#ifndef HEIGHTFIELD_HPP
+#define HEIGHTFIELD_HPP
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <glm/glm.hpp>
+#include "math/FixedNoise.hpp"
+#include "math/NoiseGraph.hpp"
+
+struct Heightfield
+{
+	glm::vec2 origin = { 0.0f, 0.0f };
+	float step = 0.125f;
+	int resolution = 0;
+
+	// Width of the border ring in samples, at least one so normals can be taken across tile edges.
+	int apron = 1;
+
+	// (resolution + 2 * apron)^2 samples, the outer ring overlaps the neighbouring tiles.
+	std::vector<float> heights = {};
+	std::vector<glm::vec3> normals = {};
+
+	void Generate(const Noise& noise, size_t octaves, float scale, float offset, NoiseQuality quality = NoiseQuality::FULL)
+	{
+		std::vector<float> dx(heights.size());
+		std::vector<float> dz(heights.size());
+
+		noise.FillGrid2DDeriv(origin.x - apron * step, origin.y - apron * step, step, GetStride(), GetStride(), octaves, heights.data(), dx.data(), dz.data(), quality);
+
+		for (size_t i = 0; i < heights.size(); i++)
+		{
+			heights[i] = heights[i] * scale + offset;
+			normals[i] = glm::normalize(glm::vec3{ -dx[i] * scale, 1.0f, -dz[i] * scale });
+		}
+	}
+
+	// The fixed point samples are bit-exact everywhere, only the conversion to world heights is float.
+	void Generate(const FixedNoise& noise, size_t octaves, float scale, float offset)
+	{
+		std::vector<int32_t> samples(heights.size());
+		const int32_t fixedStep = FixedNoise::ToFixed(step);
+
+		noise.FillGrid2D(FixedNoise::ToFixed(origin.x) - apron * fixedStep, FixedNoise::ToFixed(origin.y) - apron * fixedStep, fixedStep, GetStride(), GetStride(), octaves, samples.data());
+
+		for (size_t i = 0; i < heights.size(); i++)
+			heights[i] = FixedNoise::ToFloat(samples[i]) * scale + offset;
+
+		RecalculateNormals();
+	}
+
+	void Generate(const NoiseProgram& program)
+	{
+		program.FillGrid2D(origin.x - apron * step, origin.y - apron * step, step, GetStride(), GetStride(), heights.data());
+
+		RecalculateNormals();
+	}
+
+	void RecalculateNormals()
+	{
+		RecalculateNormals({ 0, 0, resolution - 1, resolution - 1 });
+	}
+
+	// Only the samples in region (x0, z0, x1, z1 inclusive), clamped to the interior.
+	void RecalculateNormals(const glm::ivec4& region)
+	{
+		for (int z = std::max(region.y, 0); z <= std::min(region.w, resolution - 1); z++)
+		{
+			for (int x = std::max(region.x, 0); x <= std::min(region.z, resolution - 1); x++)
+				normals[GetIndex(x, z)] = CalculateNormal(x, z);
+		}
+	}
+
+	int GetStride() const
+	{
+		return resolution + 2 * apron;
+	}
+
+	size_t GetIndex(int x, int z) const
+	{
+		return static_cast<size_t>(z + apron) * GetStride() + (x + apron);
+	}
+
+	float& At(int x, int z)
+	{
+		return heights[GetIndex(x, z)];
+	}
+
+	float Get(int x, int z) const
+	{
+		return heights[GetIndex(x, z)];
+	}
+
+	glm::vec3 GetPosition(int x, int z) const
+	{
+		return { x * step, Get(x, z), z * step };
+	}
+
+	glm::vec3 GetNormal(int x, int z) const
+	{
+		return normals[GetIndex(x, z)];
+	}
+
+	glm::vec3 CalculateNormal(int x, int z) const
+	{
+		const float dx = Get(x + 1, z) - Get(x - 1, z);
+		const float dz = Get(x, z + 1) - Get(x, z - 1);
+
+		return glm::normalize(glm::vec3{ -dx, 2.0f * step, -dz });
+	}
+
+	float Sample(float localX, float localZ) const
+	{
+		const float fx = glm::clamp(localX / step, -1.0f, static_cast<float>(resolution));
+		const float fz = glm::clamp(localZ / step, -1.0f, static_cast<float>(resolution));
+
+		const int x0 = glm::min(static_cast<int>(std::floor(fx)), resolution - 1);
+		const int z0 = glm::min(static_cast<int>(std::floor(fz)), resolution - 1);
+		const float tx = fx - x0;
+		const float tz = fz - z0;
+
+		const float top = glm::mix(Get(x0, z0), Get(x0 + 1, z0), tx);
+		const float bottom = glm::mix(Get(x0, z0 + 1), Get(x0 + 1, z0 + 1), tx);
+
+		return glm::mix(top, bottom, tz);
+	}
+
+	static Heightfield Register(const glm::vec2& origin, float step, int resolution, int apron = 1)
+	{
+		Heightfield out = {};
+
+		out.origin = origin;
+		out.step = step;
+		out.resolution = resolution;
+		out.apron = apron;
+		out.heights.resize(static_cast<size_t>(out.GetStride()) * out.GetStride());
+		out.normals.resize(out.heights.size(), { 0.0f, 1.0f, 0.0f });
+
+		return out;
+	}
+};
+
+#endif // !HEIGHTFIELD_HPP
\ No newline at end of file
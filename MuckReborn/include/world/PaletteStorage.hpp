@@ -0,0 +1,206 @@
+#ifndef PALETTE_STORAGE_HPP
+#define PALETTE_STORAGE_HPP
+
+#include <cstdint>
+#include <vector>
+#include "world/Block.hpp"
+
+// Blocks stored as indices into a palette of the types present, packed GetBits() bits each into 64 bit words with no
+// index split across two words. One type takes no words at all, the width grows as types are added and only shrinks
+// again in Compact.
+class PaletteStorage
+{
+
+public:
+
+	BlockType Get(size_t index) const
+	{
+		return palette[Read(index)];
+	}
+
+	void Set(size_t index, BlockType block)
+	{
+		const uint32_t previous = Read(index);
+
+		if (palette[previous] == block)
+			return;
+
+		const uint32_t entry = GetOrAddEntry(block);
+
+		Write(index, entry);
+		counts[previous]--;
+		counts[entry]++;
+	}
+
+	void Fill(BlockType block)
+	{
+		palette = { block };
+		counts = { static_cast<uint32_t>(count) };
+		bits = 0;
+		words.clear();
+		words.shrink_to_fit();
+	}
+
+	// Drops the palette entries nothing uses any more and repacks at the narrowest width that still fits.
+	void Compact()
+	{
+		std::vector<uint32_t> remap(palette.size(), 0);
+		std::vector<BlockType> compacted;
+		std::vector<uint32_t> compactedCounts;
+
+		for (size_t i = 0; i < palette.size(); i++)
+		{
+			if (counts[i] == 0)
+				continue;
+
+			remap[i] = static_cast<uint32_t>(compacted.size());
+			compacted.push_back(palette[i]);
+			compactedCounts.push_back(counts[i]);
+		}
+
+		if (compacted.size() == palette.size())
+			return;
+
+		std::vector<uint32_t> entries(count);
+
+		for (size_t i = 0; i < count; i++)
+			entries[i] = remap[Read(i)];
+
+		palette = std::move(compacted);
+		counts = std::move(compactedCounts);
+
+		Repack(entries, GetBitsFor(palette.size()));
+	}
+
+	bool IsUniform() const
+	{
+		return bits == 0;
+	}
+
+	int GetBits() const
+	{
+		return bits;
+	}
+
+	size_t GetPaletteSize() const
+	{
+		return palette.size();
+	}
+
+	size_t GetCount() const
+	{
+		return count;
+	}
+
+	size_t GetMemoryUsage() const
+	{
+		return sizeof(PaletteStorage) + words.capacity() * sizeof(uint64_t) + palette.capacity() * sizeof(BlockType) + counts.capacity() * sizeof(uint32_t);
+	}
+
+	static PaletteStorage Register(size_t count, BlockType fill = BlockType::AIR)
+	{
+		PaletteStorage out = {};
+
+		out.count = count;
+		out.Fill(fill);
+
+		return out;
+	}
+
+private:
+
+	static int GetBitsFor(size_t entries)
+	{
+		int out = 0;
+
+		while ((static_cast<size_t>(1) << out) < entries)
+			out++;
+
+		return out;
+	}
+
+	uint32_t Read(size_t index) const
+	{
+		if (bits == 0)
+			return 0;
+
+		const size_t perWord = 64 / bits;
+
+		return static_cast<uint32_t>((words[index / perWord] >> ((index % perWord) * bits)) & ((uint64_t(1) << bits) - 1));
+	}
+
+	void Write(size_t index, uint32_t entry)
+	{
+		const size_t perWord = 64 / bits;
+		const int shift = static_cast<int>(index % perWord) * bits;
+		const uint64_t mask = ((uint64_t(1) << bits) - 1) << shift;
+		uint64_t& word = words[index / perWord];
+
+		word = (word & ~mask) | (static_cast<uint64_t>(entry) << shift);
+	}
+
+	// Reuses an entry nothing points to before growing the palette.
+	uint32_t GetOrAddEntry(BlockType block)
+	{
+		size_t unused = palette.size();
+
+		for (size_t i = 0; i < palette.size(); i++)
+		{
+			if (palette[i] == block)
+				return static_cast<uint32_t>(i);
+
+			if (counts[i] == 0 && unused == palette.size())
+				unused = i;
+		}
+
+		if (unused < palette.size())
+		{
+			palette[unused] = block;
+			return static_cast<uint32_t>(unused);
+		}
+
+		palette.push_back(block);
+		counts.push_back(0);
+
+		if (GetBitsFor(palette.size()) > bits)
+		{
+			std::vector<uint32_t> entries(count);
+
+			for (size_t i = 0; i < count; i++)
+				entries[i] = Read(i);
+
+			Repack(entries, GetBitsFor(palette.size()));
+		}
+
+		return static_cast<uint32_t>(palette.size() - 1);
+	}
+
+	void Repack(const std::vector<uint32_t>& entries, int bits)
+	{
+		this->bits = bits;
+		words.clear();
+
+		if (bits == 0)
+		{
+			words.shrink_to_fit();
+			return;
+		}
+
+		const size_t perWord = 64 / bits;
+
+		words.assign((count + perWord - 1) / perWord, 0);
+		words.shrink_to_fit();
+
+		for (size_t i = 0; i < count; i++)
+			Write(i, entries[i]);
+	}
+
+	size_t count = 0;
+	int bits = 0;
+	std::vector<uint64_t> words = {};
+	std::vector<BlockType> palette = {};
+	std::vector<uint32_t> counts = {};
+
+};
+
+#endif // !PALETTE_STORAGE_HPP
\ No newline at end of file
@@ -0,0 +1,689 @@
+#ifndef REGION_FILE_HPP
+#define REGION_FILE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "world/EditLayer.hpp"
+#include "world/Heightfield.hpp"
+
+// Region file, version 1. Integers and floats are little endian.
+//
+//   Offset  Size  Field
+//   0       4     magic "MRRG"
+//   4       4     version, REGION_FILE_VERSION
+//   8       4     sector size in bytes, REGION_SECTOR_SIZE
+//   12      4     seed of the noise the chunks were generated from
+//   16      8192  REGION_SIZE^2 entries at local x + z * REGION_SIZE: uint32 first sector, uint32 payload length in bytes,
+//                 a length of 0 marks a chunk that was never saved
+//   8208          zero padding up to REGION_HEADER_SECTORS sectors
+//
+// A payload starts on a sector boundary and is a list of sections: uint8 RegionSection, uint8 RegionCompression, two
+// reserved bytes and a uint32 size, then size bytes. Readers skip sections they don't know. A payload is always written to
+// sectors no entry uses, the first free run it fits or the end of the file, and its entry is repointed after, so a save
+// never overwrites a payload another entry or its own previous version still points at. Sectors an entry leaves behind
+// are free for later saves.
+//
+// HEIGHTS, PLANAR_VARINT: the procedural heights, edits not included. int32 resolution, int32 apron, float step, float
+// quantum, then the (resolution + 2 * apron)^2 samples row by row in whole quanta. Each is stored as a zigzag LEB128
+// difference to left + up - up left, to the left sample on the first row, to the sample above on the first column and to
+// zero for the first one.
+//
+// EDITS, TILE_RLE: an EditLayer. int32 resolution, int32 apron, float step, float quantum, uint32 tile count, then per tile
+// a uint16 EditLayer::GetTileIndex and its EDIT_TILE_SIZE^2 differences row by row in whole quanta, as runs of a zigzag
+// LEB128 value and a LEB128 count. Tiles that round to nothing but zeros are left out.
+#define REGION_FILE_VERSION 1
+#define REGION_SIZE 32
+#define REGION_SECTOR_SIZE 4096
+#define REGION_HEADER_SECTORS 3
+#define REGION_TABLE_OFFSET 16
+
+static_assert(REGION_TABLE_OFFSET + REGION_SIZE * REGION_SIZE * 8 <= REGION_HEADER_SECTORS * REGION_SECTOR_SIZE, "Region header does not fit its sectors");
+
+enum class RegionSection : uint8_t
+{
+	HEIGHTS = 1,
+	EDITS = 2
+};
+
+enum class RegionCompression : uint8_t
+{
+	NONE = 0,
+	PLANAR_VARINT = 1,
+	TILE_RLE = 2
+};
+
+// One region file, read through a read only memory mapping. Writes are queued and go out together on Flush with plain file
+// writes, after which it is mapped again. Not thread safe, World only touches it from the main thread.
+class RegionFile
+{
+
+public:
+
+	// Opens or creates path. A file of another version or seed can't be read back and is started over.
+	bool Open(const std::string& path, uint32_t seed)
+	{
+		this->path = path;
+
+		if (std::filesystem::path(path).has_parent_path())
+			std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+
+		if (!std::filesystem::exists(path) || !Map() || !IsCompatible(seed))
+		{
+			Unmap();
+
+			if (!Create(seed) || !Map())
+				return false;
+		}
+
+		return true;
+	}
+
+	// Flushes what's queued first.
+	void Close()
+	{
+		Flush();
+		Unmap();
+	}
+
+	bool Has(int x, int z) const
+	{
+		const auto queued = pending.find(GetEntryIndex(x, z));
+
+		if (queued != pending.end())
+			return !queued->second.empty();
+
+		return GetEntry(x, z).length > 0;
+	}
+
+	// Copies the payload of the chunk at local x, z out of the mapping, or out of the queue when it has one waiting.
+	bool Read(int x, int z, std::vector<uint8_t>& out) const
+	{
+		const auto queued = pending.find(GetEntryIndex(x, z));
+
+		if (queued != pending.end())
+		{
+			out = queued->second;
+			return !out.empty();
+		}
+
+		const Entry entry = GetEntry(x, z);
+		const size_t offset = static_cast<size_t>(entry.sector) * REGION_SECTOR_SIZE;
+
+		if (entry.length == 0 || offset + entry.length > size)
+			return false;
+
+		out.assign(view + offset, view + offset + entry.length);
+
+		return true;
+	}
+
+	// Queues payload for the chunk at local x, z, an empty one clears its entry. Read and Has see it straight away, the file
+	// only changes on Flush.
+	bool Write(int x, int z, const std::vector<uint8_t>& payload)
+	{
+		if (!view || x < 0 || z < 0 || x >= REGION_SIZE || z >= REGION_SIZE)
+			return false;
+
+		pending[GetEntryIndex(x, z)] = payload;
+
+		return true;
+	}
+
+	bool HasPending() const
+	{
+		return !pending.empty();
+	}
+
+	// Writes every queued payload with one open of the file and maps it again once. The entries are only repointed after
+	// all the payloads are written, into sectors none of the current entries use, so a flush cut short leaves every chunk
+	// with the payload it had before.
+	bool Flush()
+	{
+		if (pending.empty())
+			return true;
+
+		if (!view)
+			return false;
+
+		std::vector<Entry> table(REGION_SIZE * REGION_SIZE);
+		std::memcpy(table.data(), view + REGION_TABLE_OFFSET, table.size() * sizeof(Entry));
+
+		std::vector<bool> used((size + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE, false);
+
+		auto Mark = [&](size_t first, size_t count)
+		{
+			if (used.size() < first + count)
+				used.resize(first + count, false);
+
+			std::fill(used.begin() + first, used.begin() + first + count, true);
+		};
+
+		// First free run of count sectors, or the free sectors at the end of the file and as many past it as it takes.
+		auto Allocate = [&](size_t count)
+		{
+			size_t run = 0;
+
+			for (size_t sector = REGION_HEADER_SECTORS; sector < used.size(); sector++)
+			{
+				run = used[sector] ? 0 : run + 1;
+
+				if (run == count)
+				{
+					Mark(sector + 1 - count, count);
+					return sector + 1 - count;
+				}
+			}
+
+			const size_t first = std::max<size_t>(REGION_HEADER_SECTORS, used.size() - run);
+
+			Mark(first, count);
+
+			return first;
+		};
+
+		Mark(0, REGION_HEADER_SECTORS);
+
+		for (const Entry& entry : table)
+		{
+			if (entry.length > 0)
+				Mark(entry.sector, GetSectorCount(entry.length));
+		}
+
+		std::vector<std::pair<size_t, Entry>> entries;
+
+		for (const auto& [index, payload] : pending)
+		{
+			Entry entry = {};
+
+			if (!payload.empty())
+			{
+				entry.sector = static_cast<uint32_t>(Allocate(GetSectorCount(static_cast<uint32_t>(payload.size()))));
+				entry.length = static_cast<uint32_t>(payload.size());
+			}
+
+			entries.push_back({ index, entry });
+		}
+
+		Unmap();
+
+		bool written = false;
+
+		{
+			std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+
+			if (file)
+			{
+				size_t i = 0;
+
+				for (const auto& [index, payload] : pending)
+				{
+					const Entry& entry = entries[i++].second;
+
+					if (payload.empty())
+						continue;
+
+					std::vector<uint8_t> padded(static_cast<size_t>(GetSectorCount(entry.length)) * REGION_SECTOR_SIZE, 0);
+					std::memcpy(padded.data(), payload.data(), payload.size());
+
+					file.seekp(static_cast<std::streamoff>(entry.sector) * REGION_SECTOR_SIZE);
+					file.write(reinterpret_cast<const char*>(padded.data()), padded.size());
+				}
+
+				// Every payload is on disk before any entry points at it.
+				file.flush();
+
+				for (const auto& [index, entry] : entries)
+				{
+					file.seekp(static_cast<std::streamoff>(REGION_TABLE_OFFSET + index * sizeof(Entry)));
+					file.write(reinterpret_cast<const char*>(&entry), sizeof(Entry));
+				}
+
+				written = static_cast<bool>(file);
+			}
+		}
+
+		if (written)
+			pending.clear();
+
+		return Map() && written;
+	}
+
+	static void AppendSection(std::vector<uint8_t>& payload, RegionSection section, RegionCompression compression, const std::vector<uint8_t>& data)
+	{
+		const uint8_t header[4] = { static_cast<uint8_t>(section), static_cast<uint8_t>(compression), 0, 0 };
+		const uint32_t length = static_cast<uint32_t>(data.size());
+
+		payload.insert(payload.end(), header, header + 4);
+		payload.insert(payload.end(), reinterpret_cast<const uint8_t*>(&length), reinterpret_cast<const uint8_t*>(&length) + 4);
+		payload.insert(payload.end(), data.begin(), data.end());
+	}
+
+	static bool FindSection(const std::vector<uint8_t>& payload, RegionSection section, RegionCompression& compression, const uint8_t*& data, size_t& length)
+	{
+		size_t offset = 0;
+
+		while (offset + 8 <= payload.size())
+		{
+			uint32_t size = 0;
+			std::memcpy(&size, payload.data() + offset + 4, 4);
+
+			if (offset + 8 + size > payload.size())
+				return false;
+
+			if (payload[offset] == static_cast<uint8_t>(section))
+			{
+				compression = static_cast<RegionCompression>(payload[offset + 1]);
+				data = payload.data() + offset + 8;
+				length = size;
+
+				return true;
+			}
+
+			offset += 8 + size;
+		}
+
+		return false;
+	}
+
+	// Heights in whole quanta, shared samples of neighbouring chunks quantize to the same value as the chunk mesh does.
+	static std::vector<uint8_t> EncodeHeights(const Heightfield& heightfield, float quantum)
+	{
+		const int stride = heightfield.GetStride();
+		std::vector<uint8_t> out;
+		std::vector<int64_t> row(stride, 0), previous(stride, 0);
+
+		out.reserve(16 + heightfield.heights.size() * 2);
+
+		const int32_t header[2] = { heightfield.resolution, heightfield.apron };
+		const float scale[2] = { heightfield.step, quantum };
+
+		out.insert(out.end(), reinterpret_cast<const uint8_t*>(header), reinterpret_cast<const uint8_t*>(header) + 8);
+		out.insert(out.end(), reinterpret_cast<const uint8_t*>(scale), reinterpret_cast<const uint8_t*>(scale) + 8);
+
+		for (int z = 0; z < stride; z++)
+		{
+			for (int x = 0; x < stride; x++)
+			{
+				row[x] = std::llround(heightfield.heights[static_cast<size_t>(z) * stride + x] / quantum);
+
+				WriteVarint(out, ZigZag(row[x] - Predict(row, previous, x, z)));
+			}
+
+			std::swap(row, previous);
+		}
+
+		return out;
+	}
+
+	// Fills out, which may be a coarser level over the same origin: its samples have to land on stored ones, apron included.
+	static bool DecodeHeights(const uint8_t* data, size_t length, Heightfield& out)
+	{
+		if (length < 16)
+			return false;
+
+		int32_t header[2] = {};
+		float scale[2] = {};
+
+		std::memcpy(header, data, 8);
+		std::memcpy(scale, data + 8, 8);
+
+		const int resolution = header[0];
+		const int apron = header[1];
+		const int stride = resolution + 2 * apron;
+		const float ratio = out.step / scale[0];
+		const int factor = static_cast<int>(std::lround(ratio));
+
+		if (stride <= 0 || factor < 1 || std::abs(ratio - factor) > 1e-4f || (out.resolution - 1) * factor != resolution - 1 || out.apron * factor > apron)
+			return false;
+
+		std::vector<int64_t> row(stride, 0), previous(stride, 0);
+		size_t offset = 16;
+
+		for (int z = 0; z < stride; z++)
+		{
+			for (int x = 0; x < stride; x++)
+			{
+				uint64_t value = 0;
+
+				if (!ReadVarint(data, length, offset, value))
+					return false;
+
+				row[x] = Predict(row, previous, x, z) + UnZigZag(value);
+
+				const int sampleX = x - apron;
+				const int sampleZ = z - apron;
+
+				if (sampleX % factor == 0 && sampleZ % factor == 0)
+				{
+					const int targetX = sampleX / factor;
+					const int targetZ = sampleZ / factor;
+
+					if (targetX >= -out.apron && targetX < out.resolution + out.apron && targetZ >= -out.apron && targetZ < out.resolution + out.apron)
+						out.At(targetX, targetZ) = static_cast<float>(row[x]) * scale[1];
+				}
+			}
+
+			std::swap(row, previous);
+		}
+
+		return true;
+	}
+
+	static std::vector<uint8_t> EncodeEdits(const EditLayer& edits, float quantum)
+	{
+		std::vector<uint8_t> out;
+		std::vector<uint8_t> body;
+		uint32_t count = 0;
+
+		for (const auto& [index, tile] : edits.tiles)
+		{
+			std::vector<uint8_t> runs;
+			bool empty = true;
+
+			for (size_t i = 0; i < tile.size();)
+			{
+				const int64_t value = std::llround(tile[i] / quantum);
+				size_t length = 1;
+
+				while (i + length < tile.size() && std::llround(tile[i + length] / quantum) == value)
+					length++;
+
+				WriteVarint(runs, ZigZag(value));
+				WriteVarint(runs, length);
+
+				empty = empty && value == 0;
+				i += length;
+			}
+
+			if (empty)
+				continue;
+
+			body.push_back(static_cast<uint8_t>(index & 0xFF));
+			body.push_back(static_cast<uint8_t>(index >> 8));
+			body.insert(body.end(), runs.begin(), runs.end());
+			count++;
+		}
+
+		const int32_t header[2] = { edits.resolution, edits.apron };
+		const float scale[2] = { edits.step, quantum };
+
+		out.insert(out.end(), reinterpret_cast<const uint8_t*>(header), reinterpret_cast<const uint8_t*>(header) + 8);
+		out.insert(out.end(), reinterpret_cast<const uint8_t*>(scale), reinterpret_cast<const uint8_t*>(scale) + 8);
+		out.insert(out.end(), reinterpret_cast<const uint8_t*>(&count), reinterpret_cast<const uint8_t*>(&count) + 4);
+		out.insert(out.end(), body.begin(), body.end());
+
+		return out;
+	}
+
+	// Fills the tiles of out, which has to be laid out the way the saved layer was.
+	static bool DecodeEdits(const uint8_t* data, size_t length, EditLayer& out)
+	{
+		if (length < 20)
+			return false;
+
+		int32_t header[2] = {};
+		float scale[2] = {};
+		uint32_t count = 0;
+
+		std::memcpy(header, data, 8);
+		std::memcpy(scale, data + 8, 8);
+		std::memcpy(&count, data + 16, 4);
+
+		if (header[0] != out.resolution || header[1] != out.apron || std::abs(scale[0] - out.step) > 1e-6f)
+			return false;
+
+		const int tileCount = out.GetTilesPerSide() * out.GetTilesPerSide();
+		size_t offset = 20;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (offset + 2 > length)
+				return false;
+
+			const uint16_t index = static_cast<uint16_t>(data[offset] | (data[offset + 1] << 8));
+			offset += 2;
+
+			if (index >= tileCount)
+				return false;
+
+			EditLayer::Tile& tile = out.tiles[index];
+
+			for (size_t sample = 0; sample < tile.size();)
+			{
+				uint64_t value = 0;
+				uint64_t run = 0;
+
+				if (!ReadVarint(data, length, offset, value) || !ReadVarint(data, length, offset, run) || run == 0 || sample + run > tile.size())
+					return false;
+
+				std::fill(tile.begin() + sample, tile.begin() + sample + run, static_cast<float>(UnZigZag(value)) * scale[1]);
+				sample += run;
+			}
+		}
+
+		return true;
+	}
+
+	static glm::ivec3 GetRegionCoordinate(const glm::ivec3& chunk)
+	{
+		return { FloorDivide(chunk.x), 0, FloorDivide(chunk.z) };
+	}
+
+	static glm::ivec3 GetLocalCoordinate(const glm::ivec3& chunk)
+	{
+		return chunk - GetRegionCoordinate(chunk) * REGION_SIZE;
+	}
+
+private:
+
+	struct Entry
+	{
+		uint32_t sector = 0;
+		uint32_t length = 0;
+	};
+
+	static int FloorDivide(int value)
+	{
+		return value >= 0 ? value / REGION_SIZE : -((-value + REGION_SIZE - 1) / REGION_SIZE);
+	}
+
+	static uint32_t GetSectorCount(uint32_t length)
+	{
+		return (length + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE;
+	}
+
+	static size_t GetEntryIndex(int x, int z)
+	{
+		return static_cast<size_t>(z) * REGION_SIZE + x;
+	}
+
+	static uint64_t ZigZag(int64_t value)
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	static int64_t UnZigZag(uint64_t value)
+	{
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	static void WriteVarint(std::vector<uint8_t>& out, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+
+		out.push_back(static_cast<uint8_t>(value));
+	}
+
+	static bool ReadVarint(const uint8_t* data, size_t length, size_t& offset, uint64_t& value)
+	{
+		value = 0;
+
+		for (int shift = 0; shift < 64; shift += 7)
+		{
+			if (offset >= length)
+				return false;
+
+			const uint8_t byte = data[offset++];
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+			if (!(byte & 0x80))
+				return true;
+		}
+
+		return false;
+	}
+
+	static int64_t Predict(const std::vector<int64_t>& row, const std::vector<int64_t>& previous, int x, int z)
+	{
+		if (z == 0)
+			return x == 0 ? 0 : row[x - 1];
+
+		if (x == 0)
+			return previous[0];
+
+		return row[x - 1] + previous[x] - previous[x - 1];
+	}
+
+	Entry GetEntry(int x, int z) const
+	{
+		Entry out = {};
+
+		if (!view || x < 0 || z < 0 || x >= REGION_SIZE || z >= REGION_SIZE)
+			return out;
+
+		std::memcpy(&out, view + REGION_TABLE_OFFSET + GetEntryIndex(x, z) * 8, sizeof(Entry));
+
+		return out;
+	}
+
+	bool IsCompatible(uint32_t seed) const
+	{
+		uint32_t header[4] = {};
+
+		if (size < static_cast<size_t>(REGION_HEADER_SECTORS) * REGION_SECTOR_SIZE)
+			return false;
+
+		std::memcpy(header, view, sizeof(header));
+
+		return std::memcmp(view, "MRRG", 4) == 0 && header[1] == REGION_FILE_VERSION && header[2] == REGION_SECTOR_SIZE && header[3] == seed;
+	}
+
+	bool Create(uint32_t seed)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		std::vector<uint8_t> header(static_cast<size_t>(REGION_HEADER_SECTORS) * REGION_SECTOR_SIZE, 0);
+		const uint32_t fields[3] = { REGION_FILE_VERSION, REGION_SECTOR_SIZE, seed };
+
+		std::memcpy(header.data(), "MRRG", 4);
+		std::memcpy(header.data() + 4, fields, sizeof(fields));
+
+		file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+		return static_cast<bool>(file);
+	}
+
+	bool Map()
+	{
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER length = {};
+		GetFileSizeEx(file, &length);
+		size = static_cast<size_t>(length.QuadPart);
+
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (mapping)
+			view = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+		descriptor = open(path.c_str(), O_RDONLY);
+
+		if (descriptor < 0)
+			return false;
+
+		struct stat status = {};
+		fstat(descriptor, &status);
+		size = static_cast<size_t>(status.st_size);
+
+		void* address = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0) : MAP_FAILED;
+
+		view = address == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(address);
+#endif
+
+		if (!view)
+		{
+			Unmap();
+			return false;
+		}
+
+		return true;
+	}
+
+	void Unmap()
+	{
+#ifdef _WIN32
+		if (view)
+			UnmapViewOfFile(view);
+
+		if (mapping)
+			CloseHandle(mapping);
+
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+
+		mapping = nullptr;
+		file = INVALID_HANDLE_VALUE;
+#else
+		if (view)
+			munmap(const_cast<uint8_t*>(view), size);
+
+		if (descriptor >= 0)
+			close(descriptor);
+
+		descriptor = -1;
+#endif
+
+		view = nullptr;
+		size = 0;
+	}
+
+	std::string path = "";
+	const uint8_t* view = nullptr;
+	size_t size = 0;
+
+	// Payloads waiting for Flush by GetEntryIndex, ordered so a flush always lays them out the same way.
+	std::map<size_t, std::vector<uint8_t>> pending = {};
+
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#else
+	int descriptor = -1;
+#endif
+
+};
+
+#endif // !REGION_FILE_HPP
\ No newline at end of file
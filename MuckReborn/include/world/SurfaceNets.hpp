@@ -0,0 +1,132 @@
+#ifndef SURFACE_NETS_HPP
+#define SURFACE_NETS_HPP
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "world/DensityField.hpp"
+
+// Relative to the origin of the field it came from.
+struct SurfaceVertex
+{
+	glm::vec3 position;
+	glm::vec3 normal;
+};
+
+// Naive surface nets over a DensityField. Every cell the surface passes through gets one vertex, at the mean of the
+// points where its edges cross zero, and every crossing edge becomes a quad between the four cells around it. A vertex
+// is placed once and indexed by all up to twelve quads sharing it.
+//
+// A field meshes the edges starting at its corners 0 .. cells - 1, so each edge of the world belongs to exactly one
+// field. The cells at -1 come from the apron and land on the same spots as in the neighbour, which closes the seams.
+struct SurfaceNets
+{
+	static void Generate(const DensityField& field, std::vector<SurfaceVertex>& vertices, std::vector<unsigned int>& indices)
+	{
+		static const int edges[12][2] = { { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } };
+
+		const int side = field.cells + 1;
+
+		// Vertex of each cell from -1 to cells - 1, reused between calls on the same thread.
+		thread_local std::vector<uint32_t> cache;
+
+		cache.assign(static_cast<size_t>(side) * side * side, UINT32_MAX);
+		vertices.clear();
+		indices.clear();
+
+		auto GetCell = [&](int x, int y, int z) -> uint32_t& { return cache[(static_cast<size_t>(z + 1) * side + (y + 1)) * side + (x + 1)]; };
+
+		for (int z = -1; z < field.cells; z++)
+		{
+			for (int y = -1; y < field.cells; y++)
+			{
+				for (int x = -1; x < field.cells; x++)
+				{
+					float corners[8];
+					int mask = 0;
+
+					for (int i = 0; i < 8; i++)
+					{
+						corners[i] = field.Get(x + (i & 1), y + ((i >> 1) & 1), z + ((i >> 2) & 1));
+						mask |= corners[i] > 0.0f ? 1 << i : 0;
+					}
+
+					if (mask == 0 || mask == 255)
+						continue;
+
+					glm::vec3 sum = { 0.0f, 0.0f, 0.0f };
+					int crossings = 0;
+
+					for (const int* edge : edges)
+					{
+						const int a = edge[0], b = edge[1];
+
+						if (((mask >> a) & 1) == ((mask >> b) & 1))
+							continue;
+
+						const glm::vec3 from = { static_cast<float>(a & 1), static_cast<float>((a >> 1) & 1), static_cast<float>((a >> 2) & 1) };
+						const glm::vec3 to = { static_cast<float>(b & 1), static_cast<float>((b >> 1) & 1), static_cast<float>((b >> 2) & 1) };
+
+						sum += glm::mix(from, to, corners[a] / (corners[a] - corners[b]));
+						crossings++;
+					}
+
+					// Density rises into the ground, the surface faces down its gradient.
+					const glm::vec3 gradient =
+					{
+						(corners[1] - corners[0]) + (corners[3] - corners[2]) + (corners[5] - corners[4]) + (corners[7] - corners[6]),
+						(corners[2] - corners[0]) + (corners[3] - corners[1]) + (corners[6] - corners[4]) + (corners[7] - corners[5]),
+						(corners[4] - corners[0]) + (corners[5] - corners[1]) + (corners[6] - corners[2]) + (corners[7] - corners[3])
+					};
+
+					const float length = glm::length(gradient);
+
+					GetCell(x, y, z) = static_cast<uint32_t>(vertices.size());
+					vertices.push_back({ (glm::vec3{ static_cast<float>(x), static_cast<float>(y), static_cast<float>(z) } + sum / static_cast<float>(crossings)) * field.step, length > 0.0f ? -gradient / length : glm::vec3{ 0.0f, 1.0f, 0.0f } });
+				}
+			}
+		}
+
+		for (int z = 0; z < field.cells; z++)
+		{
+			for (int y = 0; y < field.cells; y++)
+			{
+				for (int x = 0; x < field.cells; x++)
+				{
+					const bool solid = field.Get(x, y, z) > 0.0f;
+
+					for (int axis = 0; axis < 3; axis++)
+					{
+						glm::ivec3 next = { x, y, z };
+
+						next[axis]++;
+
+						if ((field.Get(next.x, next.y, next.z) > 0.0f) == solid)
+							continue;
+
+						// The four cells around the edge, counter-clockwise seen from +axis.
+						glm::ivec3 u = { 0, 0, 0 };
+						glm::ivec3 v = { 0, 0, 0 };
+
+						u[(axis + 1) % 3] = 1;
+						v[(axis + 2) % 3] = 1;
+
+						const glm::ivec3 corner = { x, y, z };
+						const uint32_t a = GetCell(corner.x - u.x - v.x, corner.y - u.y - v.y, corner.z - u.z - v.z);
+						const uint32_t b = GetCell(corner.x - v.x, corner.y - v.y, corner.z - v.z);
+						const uint32_t c = GetCell(corner.x, corner.y, corner.z);
+						const uint32_t d = GetCell(corner.x - u.x, corner.y - u.y, corner.z - u.z);
+
+						// Solid below the crossing means the surface faces +axis.
+						if (solid)
+							indices.insert(indices.end(), { a, b, c, a, c, d });
+						else
+							indices.insert(indices.end(), { a, c, b, a, d, c });
+					}
+				}
+			}
+		}
+	}
+};
+
+#endif // !SURFACE_NETS_HPP
\ No newline at end of file
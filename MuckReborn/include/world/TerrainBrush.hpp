@@ -0,0 +1,62 @@
+#ifndef TERRAIN_BRUSH_HPP
+#define TERRAIN_BRUSH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+enum class BrushMode
+{
+	RAISE,
+	LOWER,
+	FLATTEN
+};
+
+// A round terrain edit with a smooth falloff. It is evaluated at world positions, so every Heightfield holding a sample
+// makes the same change to it and edits stay seamless across chunk borders.
+struct TerrainBrush
+{
+	BrushMode mode = BrushMode::RAISE;
+	float radius = 2.0f;
+
+	// World units per second at the center for RAISE and LOWER, the rate towards target for FLATTEN.
+	float strength = 1.0f;
+	float target = 0.0f;
+
+	// 1 at the center down to 0 at radius.
+	float GetWeight(float distance) const
+	{
+		const float t = std::clamp(1.0f - distance / radius, 0.0f, 1.0f);
+
+		return t * t * (3.0f - 2.0f * t);
+	}
+
+	float Apply(float height, float weight, float deltaTime) const
+	{
+		switch (mode)
+		{
+		case BrushMode::RAISE:
+			return height + strength * weight * deltaTime;
+
+		case BrushMode::LOWER:
+			return height - strength * weight * deltaTime;
+
+		default:
+			return height + (target - height) * std::min(1.0f, strength * weight * deltaTime);
+		}
+	}
+
+	static TerrainBrush Register(BrushMode mode, float radius, float strength, float target = 0.0f)
+	{
+		TerrainBrush out = {};
+
+		out.mode = mode;
+		out.radius = radius;
+		out.strength = strength;
+		out.target = target;
+
+		return out;
+	}
+};
+
+#endif // !TERRAIN_BRUSH_HPP
\ No newline at end of file
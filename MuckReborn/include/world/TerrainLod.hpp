@@ -0,0 +1,111 @@
+#ifndef TERRAIN_LOD_HPP
+#define TERRAIN_LOD_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <glm/glm.hpp>
+
+// Distance based detail levels for square terrain chunks. Level 0 covers [0, distance), every level after it covers
+// twice the distance of the one before, so each level holds about the same number of triangles on screen.
+struct TerrainLod
+{
+	float chunkSize = 6.0f;
+	float distance = 24.0f;
+	int levels = 4;
+
+	// Part of each level's range spent morphing its odd vertices onto the next level's surface.
+	float morphFraction = 0.3f;
+
+	// Part of a level's range a chunk has to cross past a boundary before it switches, so chunks on the border don't thrash.
+	float hysteresis = 0.1f;
+
+	// Outer edge of a level in world units, the last level reaches infinity.
+	float GetRange(int level) const
+	{
+		if (level < 0)
+			return 0.0f;
+
+		if (level >= levels - 1)
+			return std::numeric_limits<float>::infinity();
+
+		return distance * static_cast<float>(1 << level);
+	}
+
+	// Distance a level spans, finite for the last level as well.
+	float GetWidth(int level) const
+	{
+		return level <= 0 ? distance : distance * static_cast<float>(1 << (level - 1));
+	}
+
+	int SelectLevel(float viewDistance) const
+	{
+		int level = 0;
+
+		while (level < levels - 1 && viewDistance >= GetRange(level))
+			level++;
+
+		return level;
+	}
+
+	// Keeps current while viewDistance stays within hysteresis of its range.
+	int SelectLevel(float viewDistance, int current) const
+	{
+		const int level = SelectLevel(viewDistance);
+
+		if (level == current || current < 0 || current >= levels)
+			return level;
+
+		const float margin = hysteresis * GetWidth(current);
+
+		if (viewDistance >= GetRange(current - 1) - margin && viewDistance < GetRange(current) + margin)
+			return current;
+
+		return level;
+	}
+
+	// Nearest a vertex of a chunk at this level gets to the viewer: the level's inner range, less the hysteresis the chunk
+	// keeps its level for and half a chunk diagonal from its centre.
+	float GetNearest(int level) const
+	{
+		if (level <= 0)
+			return 0.0f;
+
+		return std::max(GetRange(level - 1) - hysteresis * GetWidth(level) - chunkSize * 0.7071068f, 0.0f);
+	}
+
+	// Height error in world units that covers pixels on a screen screenHeight pixels tall with vertical field of view fov
+	// (radians), seen from the nearest a chunk at this level gets.
+	float GetScreenError(int level, float pixels, float screenHeight, float fov) const
+	{
+		return pixels * 2.0f * GetNearest(level) * std::tan(fov * 0.5f) / screenHeight;
+	}
+
+	// Vertex distances (x, y) over which a chunk of this level blends into the next one. The blend ends half a chunk
+	// diagonal short of the range, so a chunk's outer edge is fully morphed where the coarser neighbour starts.
+	glm::vec2 GetMorphRange(int level) const
+	{
+		if (level >= levels - 1)
+			return { std::numeric_limits<float>::max() * 0.5f, std::numeric_limits<float>::max() };
+
+		const float halfDiagonal = chunkSize * 0.7071068f;
+		const float inner = GetRange(level - 1) + halfDiagonal;
+		const float end = std::max(inner, GetRange(level) - halfDiagonal);
+		const float start = std::max(inner, end - morphFraction * GetWidth(level));
+
+		return { start, std::max(end, start + 0.001f) };
+	}
+
+	static TerrainLod Register(float chunkSize, float distance, int levels)
+	{
+		TerrainLod out = {};
+
+		out.chunkSize = chunkSize;
+		out.distance = distance;
+		out.levels = levels;
+
+		return out;
+	}
+};
+
+#endif // !TERRAIN_LOD_HPP
\ No newline at end of file
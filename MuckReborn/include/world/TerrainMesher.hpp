@@ -0,0 +1,326 @@
+#ifndef TERRAIN_MESHER_HPP
+#define TERRAIN_MESHER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#include "core/Logger.hpp"
+#include "rendering/IndexBufferManager.hpp"
+#include "rendering/Renderer.hpp"
+#include "rendering/TerrainVertex.hpp"
+#include "world/BiomeMap.hpp"
+#include "world/Heightfield.hpp"
+
+// Meshes a Heightfield as a grid of (Size * Resolution + 1)^2 shared vertices, Size in world units and Resolution cells per unit.
+// Positions come from integer sample indices, so the last column lands exactly on the neighbouring chunk's first one.
+// A ring of skirt vertices hangs below the border to hide cracks against chunks meshed at another Resolution, and
+// textureCoords.x holds each vertex's height on the grid of half this Resolution so chunkVertex.glsl can morph towards it.
+template<int Size, int Resolution>
+struct TerrainMesher
+{
+	static constexpr int Cells = Size * Resolution;
+	static constexpr int Side = Cells + 1;
+	static constexpr size_t GridVertexCount = static_cast<size_t>(Side) * Side;
+	static constexpr size_t SkirtVertexCount = static_cast<size_t>(Cells) * 4;
+	static constexpr size_t VertexCount = GridVertexCount + SkirtVertexCount;
+	static constexpr size_t IndexCount = static_cast<size_t>(Cells) * Cells * 6 + SkirtVertexCount * 6;
+	static constexpr size_t TriangleCount = IndexCount / 3;
+
+	// GenerateHeightmap texels per side, the grid plus one texel of apron for the normals at the border.
+	static constexpr int HeightmapSide = Side + 2;
+	static constexpr size_t HeightmapSize = static_cast<size_t>(HeightmapSide) * HeightmapSide * 2;
+	static constexpr bool ShortIndices = VertexCount <= 65536;
+
+	static_assert(Side <= 256, "TerrainVertex stores grid indices in a byte");
+	static_assert(Cells % 2 == 0, "TerrainMesher morphs odd vertices onto a grid of half the cells");
+	static_assert(sizeof(Vertex) == 11 * sizeof(float), "TerrainMesher writes Vertex as 11 packed floats");
+	static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "TerrainMesher reads normals as packed float triples");
+
+	static void Generate(const Heightfield& heightfield, const BiomeMap& biomeMap, const BiomeTile& biomes, float skirtDepth, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+	{
+		vertices.resize(VertexCount);
+		indices.resize(IndexCount);
+
+		GenerateVertices(heightfield, biomeMap, biomes, skirtDepth, vertices.data());
+		GenerateIndices(indices.data());
+	}
+
+	// Fills VertexCount vertices, four at a time: each field is computed across the lanes and then transposed into Vertex layout.
+	// The skirt copies the border skirtDepth lower.
+	static void GenerateVertices(const Heightfield& heightfield, const BiomeMap& biomeMap, const BiomeTile& biomes, float skirtDepth, Vertex* out)
+	{
+		if (heightfield.resolution != Side || biomes.resolution != Side)
+		{
+			Logger_ThrowError("resolution " + std::to_string(heightfield.resolution), "Heightfield or BiomeTile does not match the mesher's grid", false);
+			return;
+		}
+
+		const __m128 resolution = _mm_set1_ps(static_cast<float>(Resolution));
+		const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+		const __m128 oddLanes = _mm_castsi128_ps(_mm_set_epi32(-1, 0, -1, 0));
+		const __m128 half = _mm_set1_ps(0.5f);
+		const ptrdiff_t stride = heightfield.GetStride();
+
+		for (int z = 0; z < Side; z++)
+		{
+			const float* heights = heightfield.heights.data() + heightfield.GetIndex(0, z);
+			const float* normals = &heightfield.normals[heightfield.GetIndex(0, z)].x;
+			const __m128 positionZ = _mm_set1_ps(static_cast<float>(z) / Resolution);
+			Vertex* row = out + static_cast<size_t>(z) * Side;
+
+			int x = 0;
+
+			for (; x + 4 <= Side; x += 4)
+			{
+				const __m128 column = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lanes);
+
+				__m128 red = _mm_setzero_ps();
+				__m128 green = _mm_setzero_ps();
+				__m128 blue = _mm_setzero_ps();
+
+				for (int biome = 0; biome < BIOME_COUNT; biome++)
+				{
+					const __m128 weight = _mm_loadu_ps(biomes.GetWeights(static_cast<BiomeType>(biome)) + static_cast<size_t>(z) * Side + x);
+
+					red = _mm_add_ps(red, _mm_mul_ps(_mm_set1_ps(biomeMap.colors[biome].x), weight));
+					green = _mm_add_ps(green, _mm_mul_ps(_mm_set1_ps(biomeMap.colors[biome].y), weight));
+					blue = _mm_add_ps(blue, _mm_mul_ps(_mm_set1_ps(biomeMap.colors[biome].z), weight));
+				}
+
+				// Four packed normals x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 split into one register per axis.
+				const __m128 a = _mm_loadu_ps(normals + x * 3);
+				const __m128 b = _mm_loadu_ps(normals + x * 3 + 4);
+				const __m128 c = _mm_loadu_ps(normals + x * 3 + 8);
+				const __m128 crossed = _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2));
+				const __m128 normalX = _mm_shuffle_ps(a, crossed, _MM_SHUFFLE(2, 0, 3, 0));
+				const __m128 normalY = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 normalZ = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+				__m128 first[4] = { _mm_div_ps(column, resolution), _mm_loadu_ps(heights + x), positionZ, red };
+				__m128 second[4] = { green, blue, normalX, normalY };
+				// Heights on the coarser grid: even rows average their row neighbours, odd rows the rows around them, odd
+				// columns of odd rows the ends of the cell diagonal that GenerateIndices cuts along.
+				__m128 even = _mm_loadu_ps(heights + x);
+				__m128 odd = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(heights + x - 1), _mm_loadu_ps(heights + x + 1)), half);
+
+				if (z % 2 == 1)
+				{
+					even = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(heights - stride + x), _mm_loadu_ps(heights + stride + x)), half);
+					odd = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(heights - stride + x + 1), _mm_loadu_ps(heights + stride + x - 1)), half);
+				}
+
+				const __m128 morph = _mm_or_ps(_mm_and_ps(oddLanes, odd), _mm_andnot_ps(oddLanes, even));
+
+				__m128 third[4] = { normalZ, morph, _mm_setzero_ps(), _mm_setzero_ps() };
+
+				_MM_TRANSPOSE4_PS(first[0], first[1], first[2], first[3]);
+				_MM_TRANSPOSE4_PS(second[0], second[1], second[2], second[3]);
+				_MM_TRANSPOSE4_PS(third[0], third[1], third[2], third[3]);
+
+				for (int lane = 0; lane < 4; lane++)
+				{
+					float* vertex = reinterpret_cast<float*>(row + x + lane);
+
+					_mm_storeu_ps(vertex, first[lane]);
+					_mm_storeu_ps(vertex + 4, second[lane]);
+					_mm_storel_pi(reinterpret_cast<__m64*>(vertex + 8), third[lane]);
+					_mm_store_ss(vertex + 10, _mm_movehl_ps(third[lane], third[lane]));
+				}
+			}
+
+			for (; x < Side; x++)
+				row[x] = GetVertex(heightfield, biomeMap, biomes, x, z);
+		}
+
+		for (size_t skirt = 0; skirt < SkirtVertexCount; skirt++)
+			out[GridVertexCount + skirt] = GetSkirtVertex(out[GetBorderVertex(skirt)], skirtDepth);
+	}
+
+	static Vertex GetVertex(const Heightfield& heightfield, const BiomeMap& biomeMap, const BiomeTile& biomes, int x, int z)
+	{
+		return Vertex::Register({ static_cast<float>(x) / Resolution, heightfield.Get(x, z), static_cast<float>(z) / Resolution }, biomeMap.GetColor(biomes, x, z), heightfield.GetNormal(x, z), { GetMorphHeight(heightfield, x, z), 0.0f });
+	}
+
+	static Vertex GetSkirtVertex(Vertex border, float skirtDepth)
+	{
+		border.position.y -= skirtDepth;
+		border.textureCoords.x -= skirtDepth;
+
+		return border;
+	}
+
+	// Grid vertices whose height, normal or morph height read a sample in heights, (x0, z0, x1, z1) inclusive.
+	static glm::ivec4 GetVertexRegion(const glm::ivec4& heights)
+	{
+		return { std::max(heights.x - 1, 0), std::max(heights.y - 1, 0), std::min(heights.z + 1, Cells), std::min(heights.w + 1, Cells) };
+	}
+
+	static bool IsOnBorder(const glm::ivec4& region)
+	{
+		return region.x == 0 || region.y == 0 || region.z == Cells || region.w == Cells;
+	}
+
+	// Rewrites the TerrainVertex of every grid vertex in region and the skirt below it, after samples changed under it.
+	static void UpdateCompactVertices(const Heightfield& heightfield, const BiomeMap& biomeMap, const BiomeTile& biomes, float skirtDepth, float heightQuantum, const glm::ivec4& region, TerrainVertex* out)
+	{
+		for (int z = region.y; z <= region.w; z++)
+		{
+			for (int x = region.x; x <= region.z; x++)
+				out[static_cast<size_t>(z) * Side + x] = TerrainVertex::Register(GetVertex(heightfield, biomeMap, biomes, x, z), Resolution, heightQuantum);
+		}
+
+		if (!IsOnBorder(region))
+			return;
+
+		for (size_t skirt = 0; skirt < SkirtVertexCount; skirt++)
+		{
+			const int x = static_cast<int>(GetBorderVertex(skirt) % Side);
+			const int z = static_cast<int>(GetBorderVertex(skirt) / Side);
+
+			if (x >= region.x && x <= region.z && z >= region.y && z <= region.w)
+				out[GridVertexCount + skirt] = TerrainVertex::Register(GetSkirtVertex(GetVertex(heightfield, biomeMap, biomes, x, z), skirtDepth), Resolution, heightQuantum);
+		}
+	}
+
+	// Rewrites the height channel of GenerateHeightmap's texels over heights, returns the texels as (x0, z0, x1, z1) inclusive.
+	static glm::ivec4 UpdateHeightmap(const Heightfield& heightfield, float heightQuantum, const glm::ivec4& heights, uint16_t* out)
+	{
+		const glm::ivec4 region = { std::max(heights.x, -1), std::max(heights.y, -1), std::min(heights.z, Side), std::min(heights.w, Side) };
+
+		for (int z = region.y; z <= region.w; z++)
+		{
+			for (int x = region.x; x <= region.z; x++)
+				out[(static_cast<size_t>(z + 1) * HeightmapSide + (x + 1)) * 2] = static_cast<uint16_t>(TerrainVertex::QuantizeHeight(heightfield.Get(x, z), heightQuantum) + 32768);
+		}
+
+		return region + 1;
+	}
+
+	// GenerateVertices into a per thread scratch buffer, quantized down to TerrainVertex.
+	static void GenerateCompactVertices(const Heightfield& heightfield, const BiomeMap& biomeMap, const BiomeTile& biomes, float skirtDepth, float heightQuantum, TerrainVertex* out)
+	{
+		thread_local std::vector<Vertex> vertices;
+
+		vertices.resize(VertexCount);
+		GenerateVertices(heightfield, biomeMap, biomes, skirtDepth, vertices.data());
+
+		for (size_t i = 0; i < VertexCount; i++)
+			out[i] = TerrainVertex::Register(vertices[i], Resolution, heightQuantum);
+	}
+
+	// The surface as an RG16UI texture for chunkDisplacementVertex.glsl, which builds every vertex from gl_VertexID:
+	// r is the TerrainVertex height biased by 32768, g the color over TERRAIN_VERTEX_COLOR_RANGE as RGB565. The apron repeats the border's color.
+	static void GenerateHeightmap(const Heightfield& heightfield, const BiomeMap& biomeMap, const BiomeTile& biomes, float heightQuantum, uint16_t* out)
+	{
+		if (heightfield.resolution != Side || biomes.resolution != Side || heightfield.apron < 1)
+		{
+			Logger_ThrowError("resolution " + std::to_string(heightfield.resolution), "Heightfield or BiomeTile does not match the mesher's grid", false);
+			return;
+		}
+
+		for (int z = -1; z <= Side; z++)
+		{
+			for (int x = -1; x <= Side; x++)
+			{
+				const glm::vec3 color = glm::clamp(biomeMap.GetColor(biomes, std::clamp(x, 0, Cells), std::clamp(z, 0, Cells)) / TERRAIN_VERTEX_COLOR_RANGE, 0.0f, 1.0f);
+				uint16_t* texel = out + (static_cast<size_t>(z + 1) * HeightmapSide + (x + 1)) * 2;
+
+				texel[0] = static_cast<uint16_t>(TerrainVertex::QuantizeHeight(heightfield.Get(x, z), heightQuantum) + 32768);
+				texel[1] = static_cast<uint16_t>(std::lround(color.x * 31.0f) << 11 | std::lround(color.y * 63.0f) << 5 | std::lround(color.z * 31.0f));
+			}
+		}
+	}
+
+	static float GetMorphHeight(const Heightfield& heightfield, int x, int z)
+	{
+		if (z % 2 == 0)
+			return x % 2 == 0 ? heightfield.Get(x, z) : (heightfield.Get(x - 1, z) + heightfield.Get(x + 1, z)) * 0.5f;
+
+		if (x % 2 == 0)
+			return (heightfield.Get(x, z - 1) + heightfield.Get(x, z + 1)) * 0.5f;
+
+		return (heightfield.Get(x + 1, z - 1) + heightfield.Get(x - 1, z + 1)) * 0.5f;
+	}
+
+	// Grid vertex under skirt vertex i, walking the border counter clockwise seen from above: +x along z = 0, +z along
+	// x = Cells, -x along z = Cells and -z along x = 0.
+	static size_t GetBorderVertex(size_t i)
+	{
+		const int side = static_cast<int>(i / Cells);
+		const int offset = static_cast<int>(i % Cells);
+
+		switch (side)
+		{
+		case 0: return static_cast<size_t>(offset);
+		case 1: return static_cast<size_t>(offset) * Side + Cells;
+		case 2: return static_cast<size_t>(Cells) * Side + (Cells - offset);
+		default: return static_cast<size_t>(Cells - offset) * Side;
+		}
+	}
+
+	// Every chunk of this size shares one topology. Registers the 16-bit (when it fits) buffer on first use, main thread only.
+	static const SharedIndexBuffer& GetSharedIndices()
+	{
+		const std::string name = "terrain_" + std::to_string(Size) + "x" + std::to_string(Resolution);
+
+		if (!IndexBufferManager::HasBuffer(name))
+		{
+			if constexpr (ShortIndices)
+			{
+				std::vector<uint16_t> indices(IndexCount);
+
+				GenerateIndices(indices.data());
+				IndexBufferManager::RegisterBuffer(SharedIndexBuffer::Register(name, indices));
+			}
+			else
+			{
+				std::vector<unsigned int> indices(IndexCount);
+
+				GenerateIndices(indices.data());
+				IndexBufferManager::RegisterBuffer(SharedIndexBuffer::Register(name, indices));
+			}
+		}
+
+		return IndexBufferManager::GetBuffer(name);
+	}
+
+	// Two triangles per cell with the winding the per-quad mesher used, then two per skirt segment facing outwards.
+	template<typename Index>
+	static void GenerateIndices(Index* out)
+	{
+		for (int z = 0; z < Cells; z++)
+		{
+			for (int x = 0; x < Cells; x++)
+			{
+				const Index corner = static_cast<Index>(z * Side + x);
+
+				out[0] = corner;
+				out[1] = static_cast<Index>(corner + Side);
+				out[2] = static_cast<Index>(corner + 1);
+				out[3] = static_cast<Index>(corner + 1);
+				out[4] = static_cast<Index>(corner + Side);
+				out[5] = static_cast<Index>(corner + Side + 1);
+				out += 6;
+			}
+		}
+
+		for (size_t i = 0; i < SkirtVertexCount; i++)
+		{
+			const size_t next = (i + 1) % SkirtVertexCount;
+
+			out[0] = static_cast<Index>(GetBorderVertex(i));
+			out[1] = static_cast<Index>(GetBorderVertex(next));
+			out[2] = static_cast<Index>(GridVertexCount + i);
+			out[3] = static_cast<Index>(GetBorderVertex(next));
+			out[4] = static_cast<Index>(GridVertexCount + next);
+			out[5] = static_cast<Index>(GridVertexCount + i);
+			out += 6;
+		}
+	}
+};
+
+#endif // !TERRAIN_MESHER_HPP
\ No newline at end of file
@@ -0,0 +1,242 @@
+#ifndef VOXEL_CHUNK_HPP
+#define VOXEL_CHUNK_HPP
+
+#include <string>
+#include <vector>
+#include "math/Noise.hpp"
+#include "rendering/Renderer.hpp"
+#include "util/General.hpp"
+#include "world/Block.hpp"
+#include "world/Chunk.hpp"
+#include "world/PaletteStorage.hpp"
+#include "world/VoxelMesher.hpp"
+
+#define VOXEL_CHUNK_SIZE 16
+#define VOXEL_BLOCK_COUNT (VOXEL_CHUNK_SIZE * VOXEL_CHUNK_SIZE * VOXEL_CHUNK_SIZE)
+
+// Edge of a block in world units, so a voxel chunk covers the same CHUNK_SIZE square as a terrain chunk.
+#define VOXEL_BLOCK_SIZE (static_cast<float>(CHUNK_SIZE) / VOXEL_CHUNK_SIZE)
+
+struct VoxelChunkData : IPackagable
+{
+	RenderableObject* object = 0;
+
+	std::vector<VoxelQuad> quads = {};
+	std::vector<Vertex> vertices = {};
+	std::vector<unsigned int> indices = {};
+};
+
+// A cube of placeable and destroyable blocks, VOXEL_CHUNK_SIZE on each side, meshed with VoxelMesher and drawn through the
+// plain Vertex path of RenderableObject.
+class VoxelChunk : IPackagable
+{
+
+public:
+
+	void InitalizeChunk(const glm::ivec3& position)
+	{
+		Prepare(position);
+		Rebuild();
+	}
+
+	// position is in world units, a multiple of CHUNK_SIZE on every axis.
+	void Prepare(const glm::ivec3& position)
+	{
+		this->position = position;
+		blocks = PaletteStorage::Register(VOXEL_BLOCK_COUNT);
+	}
+
+	// Fills the columns under the same heights terrain chunks use: grass on top, then dirt, then stone, sand on the low ground.
+	void GenerateTerrain(const Noise& noise, float scale = 1.0f, float offset = 0.0f)
+	{
+		for (int z = 0; z < VOXEL_CHUNK_SIZE; z++)
+		{
+			for (int x = 0; x < VOXEL_CHUNK_SIZE; x++)
+			{
+				const float height = noise.FractalNoise(CHUNK_SIZE * 4, position.x + (x + 0.5f) * VOXEL_BLOCK_SIZE, position.z + (z + 0.5f) * VOXEL_BLOCK_SIZE) * scale + offset;
+				const int top = static_cast<int>(std::floor((height - position.y) / VOXEL_BLOCK_SIZE));
+
+				for (int y = 0; y < VOXEL_CHUNK_SIZE && y <= top; y++)
+				{
+					BlockType type = BlockType::STONE;
+
+					if (y == top)
+						type = height < 0.05f ? BlockType::SAND : BlockType::GRASS;
+					else if (y >= top - 2)
+						type = height < 0.05f ? BlockType::SAND : BlockType::DIRT;
+
+					blocks.Set(GetIndex({ x, y, z }), type);
+				}
+			}
+		}
+
+		dirty = true;
+	}
+
+	BlockType GetBlock(const glm::ivec3& local) const
+	{
+		return blocks.Get(GetIndex(local));
+	}
+
+	// Takes effect on the next Rebuild, which also has to run on a neighbour when local is on the border.
+	void SetBlock(const glm::ivec3& local, BlockType type)
+	{
+		blocks.Set(GetIndex(local), type);
+		dirty = true;
+	}
+
+	bool IsDirty() const
+	{
+		return dirty;
+	}
+
+	// Meshes the blocks into quads and vertices. neighbours are the chunks at -x, +x, -y, +y, -z and +z, a missing one
+	// counts as air. Reads but never writes the neighbours, safe on a worker as long as nothing edits them meanwhile.
+	void Mesh(const VoxelChunk* const neighbours[6] = nullptr)
+	{
+		using Mesher = VoxelMesher<VOXEL_CHUNK_SIZE>;
+
+		std::vector<BlockType> padded(Mesher::PaddedCount, BlockType::AIR);
+
+		for (int z = 0; z < VOXEL_CHUNK_SIZE; z++)
+		{
+			for (int y = 0; y < VOXEL_CHUNK_SIZE; y++)
+			{
+				for (int x = 0; x < VOXEL_CHUNK_SIZE; x++)
+					padded[Mesher::GetPaddedIndex(x, y, z)] = GetBlock({ x, y, z });
+			}
+		}
+
+		for (int face = 0; neighbours && face < 6; face++)
+		{
+			if (!neighbours[face])
+				continue;
+
+			const int axis = face / 2;
+			const int u = (axis + 1) % 3;
+			const int v = (axis + 2) % 3;
+
+			for (int j = 0; j < VOXEL_CHUNK_SIZE; j++)
+			{
+				for (int i = 0; i < VOXEL_CHUNK_SIZE; i++)
+				{
+					glm::ivec3 border = {};
+					glm::ivec3 source = {};
+
+					border[axis] = face % 2 == 1 ? VOXEL_CHUNK_SIZE : -1;
+					source[axis] = face % 2 == 1 ? 0 : VOXEL_CHUNK_SIZE - 1;
+					border[u] = source[u] = i;
+					border[v] = source[v] = j;
+
+					padded[Mesher::GetPaddedIndex(border.x, border.y, border.z)] = neighbours[face]->GetBlock(source);
+				}
+			}
+		}
+
+		Mesher::Generate(padded.data(), data.quads);
+
+		data.vertices.clear();
+		data.indices.clear();
+		data.vertices.reserve(data.quads.size() * 4);
+		data.indices.reserve(data.quads.size() * 6);
+
+		for (const VoxelQuad& quad : data.quads)
+			AddQuad(quad);
+
+		dirty = false;
+	}
+
+	// Main thread only, replaces the renderable object with one holding the mesh from Mesh.
+	void Upload()
+	{
+		if (data.object)
+		{
+			Renderer::UnregisterRenderableObject(data.object);
+			data.object->CleanUp();
+			data.object = nullptr;
+		}
+
+		if (data.indices.empty())
+			return;
+
+		data.object = RenderableObject::Register("VoxelChunk(" + std::to_string(position.x) + ", " + std::to_string(position.y) + ", " + std::to_string(position.z) + ")", data.vertices, data.indices, false, false, ShaderManager::GetGeneratedShader("voxel", ShaderType::VOXEL));
+		data.object->data.shaders["shadow"] = ShaderManager::GetGeneratedShader("shadow", ShaderType::SHADOW);
+		data.object->data.transform.position = position;
+		data.object->RegisterTexture(TextureManager::GetGeneratedTexture("test_texture"));
+		data.object->GenerateRawData();
+
+		// RenderableObject keeps its own copy.
+		data.vertices = {};
+		data.indices = {};
+
+		Renderer::RegisterRenderableObject(data.object);
+	}
+
+	void Rebuild()
+	{
+		Mesh();
+		Upload();
+	}
+
+	size_t GetQuadCount() const
+	{
+		return data.quads.size();
+	}
+
+	void CleanUp()
+	{
+		if (data.object)
+		{
+			Renderer::UnregisterRenderableObject(data.object);
+			data.object->CleanUp();
+		}
+
+		delete this;
+	}
+
+	VoxelChunkData data;
+	PaletteStorage blocks;
+
+private:
+
+	static size_t GetIndex(const glm::ivec3& local)
+	{
+		return (static_cast<size_t>(local.z) * VOXEL_CHUNK_SIZE + local.y) * VOXEL_CHUNK_SIZE + local.x;
+	}
+
+	// Counter-clockwise seen from the side the face points to, width * height texture repeats so a merged face tiles.
+	void AddQuad(const VoxelQuad& quad)
+	{
+		const int axis = quad.GetAxis();
+		glm::vec3 corner = glm::vec3{ static_cast<float>(quad.x), static_cast<float>(quad.y), static_cast<float>(quad.z) } * VOXEL_BLOCK_SIZE;
+		glm::vec3 width = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 height = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 normal = { 0.0f, 0.0f, 0.0f };
+
+		width[(axis + 1) % 3] = quad.width * VOXEL_BLOCK_SIZE;
+		height[(axis + 2) % 3] = quad.height * VOXEL_BLOCK_SIZE;
+		normal[axis] = quad.IsPositive() ? 1.0f : -1.0f;
+
+		if (quad.IsPositive())
+			corner[axis] += VOXEL_BLOCK_SIZE;
+
+		const glm::vec3 color = Block::GetColor(quad.type);
+		const unsigned int first = static_cast<unsigned int>(data.vertices.size());
+
+		data.vertices.push_back(Vertex::Register(corner, color, normal, { 0.0f, 0.0f }));
+		data.vertices.push_back(Vertex::Register(corner + width, color, normal, { static_cast<float>(quad.width), 0.0f }));
+		data.vertices.push_back(Vertex::Register(corner + width + height, color, normal, { static_cast<float>(quad.width), static_cast<float>(quad.height) }));
+		data.vertices.push_back(Vertex::Register(corner + height, color, normal, { 0.0f, static_cast<float>(quad.height) }));
+
+		if (quad.IsPositive())
+			data.indices.insert(data.indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+		else
+			data.indices.insert(data.indices.end(), { first, first + 2, first + 1, first, first + 3, first + 2 });
+	}
+
+	glm::ivec3 position = { 0, 0, 0 };
+	bool dirty = false;
+
+};
+
+#endif // !VOXEL_CHUNK_HPP
\ No newline at end of file
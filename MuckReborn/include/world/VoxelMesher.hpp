@@ -0,0 +1,163 @@
+#ifndef VOXEL_MESHER_HPP
+#define VOXEL_MESHER_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "world/Block.hpp"
+
+// One merged face: width by height blocks in the plane of face, from the block corner (x, y, z). face is axis * 2 plus
+// one for the side facing +axis, width runs along axis + 1 and height along axis + 2, both mod 3.
+struct VoxelQuad
+{
+	uint8_t x = 0, y = 0, z = 0;
+	uint8_t width = 1, height = 1;
+	uint8_t face = 0;
+	BlockType type = BlockType::AIR;
+
+	int GetAxis() const
+	{
+		return face / 2;
+	}
+
+	bool IsPositive() const
+	{
+		return face % 2 == 1;
+	}
+};
+
+// Greedy meshing of a Size^3 block chunk. Blocks come with a one block border of the neighbouring chunks, (Size + 2)^3
+// in GetPaddedIndex order, so faces against a neighbour's solid block are left out like any other hidden face.
+template<int Size>
+struct VoxelMesher
+{
+	static constexpr int PaddedSide = Size + 2;
+	static constexpr size_t PaddedCount = static_cast<size_t>(PaddedSide) * PaddedSide * PaddedSide;
+
+	static_assert(Size <= 255, "VoxelQuad stores positions and sizes in a byte");
+
+	static size_t GetPaddedIndex(int x, int y, int z)
+	{
+		return (static_cast<size_t>(z + 1) * PaddedSide + (y + 1)) * PaddedSide + (x + 1);
+	}
+
+	// Sweeps a Size^2 mask of the visible faces through every slice of each of the six directions and grows each unvisited
+	// face first along width, then along height, while the faces it covers are visible and of the same type.
+	static void Generate(const BlockType* padded, std::vector<VoxelQuad>& quads)
+	{
+		std::array<BlockType, Size * Size> mask = {};
+
+		quads.clear();
+
+		for (int face = 0; face < 6; face++)
+		{
+			const int axis = face / 2;
+			const int u = (axis + 1) % 3;
+			const int v = (axis + 2) % 3;
+			const int side = face % 2 == 1 ? 1 : -1;
+
+			for (int slice = 0; slice < Size; slice++)
+			{
+				int position[3] = {};
+
+				position[axis] = slice;
+
+				for (int j = 0; j < Size; j++)
+				{
+					for (int i = 0; i < Size; i++)
+					{
+						position[u] = i;
+						position[v] = j;
+
+						const BlockType block = padded[GetPaddedIndex(position[0], position[1], position[2])];
+
+						position[axis] += side;
+
+						const bool hidden = Block::IsSolid(padded[GetPaddedIndex(position[0], position[1], position[2])]);
+
+						position[axis] -= side;
+						mask[j * Size + i] = hidden ? BlockType::AIR : block;
+					}
+				}
+
+				for (int j = 0; j < Size; j++)
+				{
+					for (int i = 0; i < Size;)
+					{
+						const BlockType type = mask[j * Size + i];
+
+						if (!Block::IsSolid(type))
+						{
+							i++;
+							continue;
+						}
+
+						int width = 1;
+
+						while (i + width < Size && mask[j * Size + i + width] == type)
+							width++;
+
+						int height = 1;
+
+						for (; j + height < Size; height++)
+						{
+							bool matches = true;
+
+							for (int k = 0; k < width && matches; k++)
+								matches = mask[(j + height) * Size + i + k] == type;
+
+							if (!matches)
+								break;
+						}
+
+						for (int l = 0; l < height; l++)
+						{
+							for (int k = 0; k < width; k++)
+								mask[(j + l) * Size + i + k] = BlockType::AIR;
+						}
+
+						VoxelQuad quad = {};
+						uint8_t* corner[3] = { &quad.x, &quad.y, &quad.z };
+
+						*corner[axis] = static_cast<uint8_t>(slice);
+						*corner[u] = static_cast<uint8_t>(i);
+						*corner[v] = static_cast<uint8_t>(j);
+						quad.width = static_cast<uint8_t>(width);
+						quad.height = static_cast<uint8_t>(height);
+						quad.face = static_cast<uint8_t>(face);
+						quad.type = type;
+
+						quads.push_back(quad);
+						i += width;
+					}
+				}
+			}
+		}
+	}
+
+	// Faces a mesher emitting one quad per visible block face would give, what Generate is measured against.
+	static size_t CountFaces(const BlockType* padded)
+	{
+		static const int offsets[6][3] = { { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+		size_t out = 0;
+
+		for (int z = 0; z < Size; z++)
+		{
+			for (int y = 0; y < Size; y++)
+			{
+				for (int x = 0; x < Size; x++)
+				{
+					if (!Block::IsSolid(padded[GetPaddedIndex(x, y, z)]))
+						continue;
+
+					for (const int* offset : offsets)
+						out += Block::IsSolid(padded[GetPaddedIndex(x + offset[0], y + offset[1], z + offset[2])]) ? 0 : 1;
+				}
+			}
+		}
+
+		return out;
+	}
+};
+
+#endif // !VOXEL_MESHER_HPP
\ No newline at end of file
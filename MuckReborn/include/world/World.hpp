@@ -1,9 +1,676 @@
 #ifndef WORLD_HPP
 #define WORLD_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/ThreadPool.hpp"
+#include "world/Chunk.hpp"
+#include "world/ChunkStage.hpp"
+#include "world/RegionFile.hpp"
+
+// Radii in chunks around the player, unloading further out than loading keeps chunks on the border from thrashing.
+// Chunks past CHUNK_LOD_DISTANCE mesh at lower levels, which is what keeps this radius affordable.
+#define WORLD_LOAD_RADIUS 12
+#define WORLD_UNLOAD_RADIUS 14
+#define WORLD_UPLOADS_PER_FRAME 2
+
+// How many chunks of distance a chunk straight ahead is worth over one straight behind.
+#define WORLD_VIEW_PRIORITY 2.0f
+
+// Region files are named r.<x>.<z>.region in here, see RegionFile.hpp for the format.
+#define WORLD_SAVE_DIRECTORY "saves/world"
+
+// NoiseGraph text replacing the built in terrain, relative to the asset domain. Optional.
+#define WORLD_TERRAIN_GRAPH "terrain/terrain.graph"
+
+struct ChunkCoordinateHash
+{
+	size_t operator()(const glm::ivec3& coordinate) const
+	{
+		size_t hash = static_cast<size_t>(coordinate.x) * 73856093u;
+		hash ^= static_cast<size_t>(coordinate.y) * 19349663u;
+		hash ^= static_cast<size_t>(coordinate.z) * 83492791u;
+
+		return hash;
+	}
+};
+
+// A chunk on its way through the stages of generation. Only the main thread creates, uploads or frees them.
+struct ChunkRequest
+{
+	glm::ivec3 coordinate = { 0, 0, 0 };
+	Chunk* chunk = nullptr;
+	float priority = 0.0f;
+
+	// EditLayer::revision of the edits the chunk was given.
+	uint32_t editRevision = 0;
+	std::atomic<bool> cancelled = { false };
+
+	// Last stage the chunk finished, set by the worker that ran it and read by the main thread to schedule its neighbours.
+	std::atomic<ChunkStage> stage = { ChunkStage::NONE };
+
+	// Queued or on a worker, main thread only.
+	bool scheduled = false;
+};
+
 namespace World
 {
+	extern std::unordered_map<glm::ivec3, Chunk*, ChunkCoordinateHash> chunks;
+	extern std::unordered_map<glm::ivec3, std::shared_ptr<ChunkRequest>, ChunkCoordinateHash> requests;
+
+	// Guarded by requestMutex, queued is ordered by priority when a worker picks from it and completed holds the requests
+	// workers are done with until the main thread schedules their next stage.
+	extern std::vector<std::shared_ptr<ChunkRequest>> queued;
+	extern std::vector<std::shared_ptr<ChunkRequest>> completed;
+	extern std::mutex requestMutex;
+
+	extern ThreadPool* pool;
+	extern ChunkStageTimer stageTimer;
+
+	// Compiled from WORLD_TERRAIN_GRAPH, null when there's none and chunks use their own noise.
+	extern NoiseProgram* terrainProgram;
+
+	// Opened the first time a chunk inside them is loaded or saved and closed by FlushRegions once none of their chunks
+	// are loaded, main thread only.
+	extern std::unordered_map<glm::ivec3, RegionFile*, ChunkCoordinateHash> regions;
+
+	// Edits of the loaded chunks that have any, read from their region when they load and dropped once saved on unload.
+	// Main thread only, workers get a copy.
+	extern std::unordered_map<glm::ivec3, EditLayer, ChunkCoordinateHash> edits;
+
+	glm::ivec3 GetChunkCoordinate(float x, float z)
+	{
+		return { static_cast<int>(std::floor(x / CHUNK_SIZE)), 0, static_cast<int>(std::floor(z / CHUNK_SIZE)) };
+	}
+
+	void RegisterChunk(Chunk* chunk)
+	{
+		chunks[GetChunkCoordinate(chunk->heightfield.origin.x, chunk->heightfield.origin.y)] = chunk;
+	}
+
+	void UnregisterChunk(Chunk* chunk)
+	{
+		chunks.erase(GetChunkCoordinate(chunk->heightfield.origin.x, chunk->heightfield.origin.y));
+	}
+
+	Chunk* GetChunk(const glm::ivec3& coordinate)
+	{
+		auto iterator = chunks.find(coordinate);
+
+		if (iterator == chunks.end())
+			return nullptr;
+
+		return iterator->second;
+	}
+
+	RegionFile* GetRegion(const glm::ivec3& coordinate, uint32_t seed)
+	{
+		const glm::ivec3 region = RegionFile::GetRegionCoordinate(coordinate);
+		auto iterator = regions.find(region);
+
+		if (iterator != regions.end())
+			return iterator->second;
+
+		RegionFile* out = new RegionFile();
+
+		if (!out->Open(std::string(WORLD_SAVE_DIRECTORY) + "/r." + std::to_string(region.x) + "." + std::to_string(region.z) + ".region", seed))
+		{
+			Logger_ThrowError("Region", "Failed to open region (" + std::to_string(region.x) + ", " + std::to_string(region.z) + ") in '" WORLD_SAVE_DIRECTORY "'", false);
+
+			delete out;
+			out = nullptr;
+		}
+
+		regions[region] = out;
+
+		return out;
+	}
+
+	// Writes what SaveChunk queued this frame, one remap per region however many chunks unloaded, and closes the regions no
+	// loaded chunk or request lies in any more so only the ones around the player stay mapped.
+	void FlushRegions()
+	{
+		std::unordered_set<glm::ivec3, ChunkCoordinateHash> active;
+
+		for (const auto& [coordinate, chunk] : chunks)
+			active.insert(RegionFile::GetRegionCoordinate(coordinate));
+
+		for (const auto& [coordinate, request] : requests)
+			active.insert(RegionFile::GetRegionCoordinate(coordinate));
+
+		for (auto iterator = regions.begin(); iterator != regions.end();)
+		{
+			RegionFile* region = iterator->second;
+
+			if (active.count(iterator->first))
+			{
+				if (region)
+					region->Flush();
+
+				++iterator;
+				continue;
+			}
+
+			if (region)
+				region->Close();
+
+			delete region;
+			iterator = regions.erase(iterator);
+		}
+	}
+
+	uint32_t GetEditRevision(const glm::ivec3& coordinate)
+	{
+		auto iterator = edits.find(coordinate);
+
+		return iterator == edits.end() ? 0 : iterator->second.revision;
+	}
+
+	// Writes chunk and its edits to its region if either has anything new, call before cleaning it up.
+	void SaveChunk(const glm::ivec3& coordinate, Chunk* chunk)
+	{
+		auto layer = edits.find(coordinate);
+		EditLayer* chunkEdits = layer == edits.end() ? nullptr : &layer->second;
+
+		if (!chunk->IsModified() && !(chunkEdits && chunkEdits->modified))
+			return;
+
+		if (RegionFile* region = GetRegion(coordinate, chunk->GetSeed()))
+		{
+			const glm::ivec3 local = RegionFile::GetLocalCoordinate(coordinate);
+
+			chunk->Save(*region, local.x, local.z, chunkEdits);
+		}
+	}
+
+	float GetHeightAt(float x, float z)
+	{
+		Chunk* chunk = GetChunk(GetChunkCoordinate(x, z));
+
+		if (!chunk)
+			return 0.0f;
+
+		return chunk->GetHeightAt(x, z);
+	}
+
+	// Distance from the viewer to the middle of the chunk in world units, what a chunk's detail level is picked from.
+	float GetViewDistance(const glm::ivec3& coordinate, const glm::vec3& position)
+	{
+		const glm::vec2 middle = glm::vec2{ static_cast<float>(coordinate.x), static_cast<float>(coordinate.z) } * static_cast<float>(CHUNK_SIZE) + CHUNK_SIZE * 0.5f;
+
+		return glm::length(middle - glm::vec2{ position.x, position.z });
+	}
+
+	// Applies brush to every loaded chunk holding a sample under it, neighbours included when it straddles a border, and
+	// to their edits. One world unit of margin covers CHUNK_EDIT_APRON, the apron samples the border normals are taken
+	// from at the coarsest level. Edits are measured against level 0 heights, so nothing changes while any of those
+	// chunks is at a coarser level, rather than leaving a seam between the ones that could take it and the ones that couldn't.
+	void ApplyBrush(const TerrainBrush& brush, const glm::vec2& center, float deltaTime)
+	{
+		const float reach = brush.radius + 1.0f;
+		const glm::ivec3 first = GetChunkCoordinate(center.x - reach, center.y - reach);
+		const glm::ivec3 last = GetChunkCoordinate(center.x + reach, center.y + reach);
+
+		for (int z = first.z; z <= last.z; z++)
+		{
+			for (int x = first.x; x <= last.x; x++)
+			{
+				const Chunk* chunk = GetChunk({ x, 0, z });
+
+				if (chunk && chunk->GetLevel() != 0)
+					return;
+			}
+		}
+
+		for (int z = first.z; z <= last.z; z++)
+		{
+			for (int x = first.x; x <= last.x; x++)
+			{
+				const glm::ivec3 coordinate = { x, 0, z };
+				Chunk* chunk = GetChunk(coordinate);
+
+				if (!chunk)
+					continue;
+
+				EditLayer& layer = edits.try_emplace(coordinate, Chunk::RegisterEdits(coordinate * CHUNK_SIZE)).first->second;
+
+				chunk->ApplyBrush(brush, center, deltaTime, layer);
+
+				if (layer.IsEmpty())
+					edits.erase(coordinate);
+			}
+		}
+	}
+
+	// Marches along direction until it passes below the loaded terrain, then bisects onto the surface.
+	bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, glm::vec3& hit)
+	{
+		const float step = 0.25f;
+		const glm::vec3 ray = glm::normalize(direction);
+
+		auto IsBelow = [](const glm::vec3& point) { return point.y <= GetHeightAt(point.x, point.z); };
+
+		if (IsBelow(origin))
+			return false;
+
+		for (float distance = step; distance <= maxDistance; distance += step)
+		{
+			if (!IsBelow(origin + ray * distance))
+				continue;
+
+			float above = distance - step;
+			float below = distance;
+
+			for (int i = 0; i < 16; i++)
+			{
+				const float middle = (above + below) * 0.5f;
+
+				if (IsBelow(origin + ray * middle))
+					below = middle;
+				else
+					above = middle;
+			}
+
+			hit = origin + ray * below;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	// Compiled against the same Noise every chunk generates with, so the graph's seed matches the region files'.
+	void LoadTerrainProgram()
+	{
+		const std::string path = "assets/" + Settings::defaultDomain + "/" + WORLD_TERRAIN_GRAPH;
+
+		if (!std::filesystem::exists(path))
+			return;
+
+		NoiseGraph graph;
+		std::string error;
+
+		if (!NoiseGraph::Parse(LoadFile(path), graph, error))
+		{
+			Logger_ThrowError(path, "Terrain graph failed to parse, using the built in terrain: " + error, false);
+			return;
+		}
+
+		terrainProgram = new NoiseProgram(graph.Compile(Noise(0.45, 10)));
+	}
+
+	void InitalizeWorld(size_t threadCount = std::max<size_t>(2, std::thread::hardware_concurrency()) - 1)
+	{
+		pool = new ThreadPool(threadCount);
+
+		LoadTerrainProgram();
+	}
+
+	// Lower is sooner, distance in chunks with chunks in front of the camera pulled forward.
+	float GetPriority(const glm::ivec3& coordinate, const glm::ivec3& center, const glm::vec3& forward)
+	{
+		const glm::vec2 offset = { static_cast<float>(coordinate.x - center.x), static_cast<float>(coordinate.z - center.z) };
+		const float distance = glm::length(offset);
+		const glm::vec2 direction = { forward.x, forward.z };
 
+		if (distance <= 0.0f)
+			return -WORLD_VIEW_PRIORITY;
+
+		if (glm::length(direction) <= 0.0f)
+			return distance;
+
+		return distance - WORLD_VIEW_PRIORITY * 0.5f * (1.0f + glm::dot(offset / distance, glm::normalize(direction)));
+	}
+
+	// The chunks at -x, +x, -z and +z of coordinate at level, a request over the loaded chunk it replaces. False while one of
+	// them hasn't reached stage yet, out is left null for a missing neighbour or one at another level, which never hold a
+	// chunk up.
+	bool GetNeighbours(const glm::ivec3& coordinate, int level, ChunkStage stage, const Chunk* out[4])
+	{
+		static const glm::ivec3 offsets[4] = { { -1, 0, 0 }, { 1, 0, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+
+		for (int i = 0; i < 4; i++)
+		{
+			const glm::ivec3 neighbour = coordinate + offsets[i];
+			auto request = requests.find(neighbour);
+			const Chunk* chunk = nullptr;
+
+			if (request != requests.end() && !request->second->cancelled)
+			{
+				chunk = request->second->chunk;
+
+				if (chunk->GetLevel() == level && request->second->stage < stage)
+					return false;
+			}
+			else
+				chunk = GetChunk(neighbour);
+
+			out[i] = chunk && chunk->GetLevel() == level ? chunk : nullptr;
+		}
+
+		return true;
+	}
+
+	// Runs the queued request's next stage, then the ones after it for as long as they don't wait on neighbours, and hands
+	// it back to the main thread.
+	void GenerateNextRequest()
+	{
+		std::shared_ptr<ChunkRequest> request;
+
+		{
+			std::lock_guard<std::mutex> lock(requestMutex);
+
+			if (queued.empty())
+				return;
+
+			auto best = std::min_element(queued.begin(), queued.end(), [](const std::shared_ptr<ChunkRequest>& a, const std::shared_ptr<ChunkRequest>& b) { return a->priority < b->priority; });
+
+			request = *best;
+			queued.erase(best);
+		}
+
+		for (ChunkStage stage = ChunkStages::GetNext(request->stage); !request->cancelled; stage = ChunkStages::GetNext(stage))
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			request->chunk->RunStage(stage);
+			stageTimer.Record(stage, std::chrono::steady_clock::now() - start);
+			request->stage = stage;
+
+			const ChunkStage next = ChunkStages::GetNext(stage);
+
+			if (next == ChunkStage::UPLOAD || ChunkStages::GetRequirement(next) != ChunkStage::NONE)
+				break;
+		}
+
+		std::lock_guard<std::mutex> lock(requestMutex);
+		completed.push_back(request);
+	}
+
+	// Call once per frame from the main thread. Unloads and cancels chunks that fell out of range, queues the missing ones and
+	// the ones whose detail level changed, hands each request's next stage to the workers once its neighbours are far
+	// enough along, and uploads up to WORLD_UPLOADS_PER_FRAME meshed chunks. A chunk changing level stays on screen until
+	// its replacement is uploaded.
+	void Update(const glm::vec3& position, const glm::vec3& forward)
+	{
+		const glm::ivec3 center = GetChunkCoordinate(position.x, position.z);
+
+		auto IsOutside = [&](const glm::ivec3& coordinate, int radius)
+		{
+			const int x = coordinate.x - center.x;
+			const int z = coordinate.z - center.z;
+
+			return x * x + z * z > radius * radius;
+		};
+
+		for (auto iterator = chunks.begin(); iterator != chunks.end();)
+		{
+			if (IsOutside(iterator->first, WORLD_UNLOAD_RADIUS))
+			{
+				SaveChunk(iterator->first, iterator->second);
+				edits.erase(iterator->first);
+				iterator->second->CleanUp();
+				iterator = chunks.erase(iterator);
+			}
+			else
+				++iterator;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(requestMutex);
+
+			for (auto iterator = queued.begin(); iterator != queued.end();)
+			{
+				if (IsOutside((*iterator)->coordinate, WORLD_UNLOAD_RADIUS))
+				{
+					(*iterator)->cancelled = true;
+					(*iterator)->scheduled = false;
+					iterator = queued.erase(iterator);
+				}
+				else
+				{
+					(*iterator)->priority = GetPriority((*iterator)->coordinate, center, forward);
+					++iterator;
+				}
+			}
+
+			for (const std::shared_ptr<ChunkRequest>& request : completed)
+				request->scheduled = false;
+
+			completed.clear();
+		}
+
+		// Requests on a worker finish their stage first, then come back through completed as cancelled.
+		for (auto iterator = requests.begin(); iterator != requests.end();)
+		{
+			const std::shared_ptr<ChunkRequest>& request = iterator->second;
+
+			if (IsOutside(request->coordinate, WORLD_UNLOAD_RADIUS))
+				request->cancelled = true;
+
+			if (request->scheduled)
+			{
+				++iterator;
+				continue;
+			}
+
+			if (request->cancelled)
+			{
+				// Edits read in for a chunk that never made it, they're still in its region.
+				if (!GetChunk(request->coordinate))
+					edits.erase(request->coordinate);
+
+				request->chunk->CleanUp();
+				iterator = requests.erase(iterator);
+				continue;
+			}
+
+			// Edited since it was given its edits, only decoration and the stages after it see them.
+			if (request->editRevision != GetEditRevision(request->coordinate))
+			{
+				auto layer = edits.find(request->coordinate);
+
+				request->chunk->SetEdits(layer == edits.end() ? EditLayer() : layer->second);
+				request->editRevision = GetEditRevision(request->coordinate);
+				request->stage = std::min(request->stage.load(), ChunkStage::EROSION);
+			}
+
+			++iterator;
+		}
+
+		std::vector<std::shared_ptr<ChunkRequest>> ready;
+		std::vector<std::shared_ptr<ChunkRequest>> meshed;
+
+		for (auto& [coordinate, request] : requests)
+		{
+			if (request->scheduled)
+				continue;
+
+			const ChunkStage next = ChunkStages::GetNext(request->stage);
+			const Chunk* neighbours[4] = {};
+
+			if (next == ChunkStage::UPLOAD)
+				meshed.push_back(request);
+			else if (ChunkStages::GetRequirement(next) == ChunkStage::NONE)
+				ready.push_back(request);
+			else if (GetNeighbours(coordinate, request->chunk->GetLevel(), ChunkStages::GetRequirement(next), neighbours))
+			{
+				if (next == ChunkStage::MESH)
+					request->chunk->Stitch(neighbours);
+
+				ready.push_back(request);
+			}
+		}
+
+		std::sort(meshed.begin(), meshed.end(), [](const std::shared_ptr<ChunkRequest>& a, const std::shared_ptr<ChunkRequest>& b) { return a->priority < b->priority; });
+
+		for (size_t i = 0; i < meshed.size() && i < WORLD_UPLOADS_PER_FRAME; i++)
+		{
+			const std::shared_ptr<ChunkRequest>& request = meshed[i];
+
+			if (Chunk* previous = GetChunk(request->coordinate))
+			{
+				SaveChunk(request->coordinate, previous);
+				previous->CleanUp();
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+
+			request->chunk->Upload();
+			stageTimer.Record(ChunkStage::UPLOAD, std::chrono::steady_clock::now() - start);
+			request->stage = ChunkStage::UPLOAD;
+
+			RegisterChunk(request->chunk);
+			requests.erase(request->coordinate);
+		}
+
+		for (int z = -WORLD_LOAD_RADIUS; z <= WORLD_LOAD_RADIUS; z++)
+		{
+			for (int x = -WORLD_LOAD_RADIUS; x <= WORLD_LOAD_RADIUS; x++)
+			{
+				const glm::ivec3 coordinate = { center.x + x, 0, center.z + z };
+
+				if (IsOutside(coordinate, WORLD_LOAD_RADIUS) || requests.count(coordinate))
+					continue;
+
+				const Chunk* existing = GetChunk(coordinate);
+				const float viewDistance = GetViewDistance(coordinate, position);
+				const int level = Chunk::GetLod().SelectLevel(viewDistance, existing ? existing->GetLevel() : -1);
+
+				// Regenerated when either its level or the noise tier that level gets has changed.
+				if (existing && existing->GetLevel() == level && existing->GetQuality() == existing->SelectQuality(level))
+					continue;
+
+				auto request = std::make_shared<ChunkRequest>();
+
+				request->coordinate = coordinate;
+				request->priority = GetPriority(coordinate, center, forward);
+				request->chunk = new Chunk();
+				request->chunk->Prepare(coordinate * CHUNK_SIZE, viewDistance, level);
+				request->chunk->SetTerrainProgram(terrainProgram);
+
+				// Copied out of the mapping here, the worker never touches a region file. Saved edits only load when the
+				// chunk isn't loaded already, otherwise the ones in memory are newer.
+				if (RegionFile* region = GetRegion(coordinate, request->chunk->GetSeed()))
+				{
+					const glm::ivec3 local = RegionFile::GetLocalCoordinate(coordinate);
+					std::vector<uint8_t> payload;
+					RegionCompression compression = RegionCompression::NONE;
+					const uint8_t* section = nullptr;
+					size_t length = 0;
+
+					if (region->Read(local.x, local.z, payload))
+					{
+						if (!existing && RegionFile::FindSection(payload, RegionSection::EDITS, compression, section, length) && compression == RegionCompression::TILE_RLE)
+						{
+							EditLayer layer = Chunk::RegisterEdits(coordinate * CHUNK_SIZE);
+
+							if (RegionFile::DecodeEdits(section, length, layer) && !layer.IsEmpty())
+								edits[coordinate] = std::move(layer);
+						}
+
+						request->chunk->SetSaved(std::move(payload));
+					}
+				}
+
+				if (auto layer = edits.find(coordinate); layer != edits.end())
+				{
+					request->chunk->SetEdits(layer->second);
+					request->editRevision = layer->second.revision;
+				}
+
+				requests[coordinate] = request;
+				ready.push_back(request);
+			}
+		}
+
+		FlushRegions();
+
+		if (ready.empty())
+			return;
+
+		for (const std::shared_ptr<ChunkRequest>& request : ready)
+			request->scheduled = true;
+
+		{
+			std::lock_guard<std::mutex> lock(requestMutex);
+			queued.insert(queued.end(), ready.begin(), ready.end());
+		}
+
+		for (size_t i = 0; i < ready.size(); i++)
+			pool->Submit([]() { GenerateNextRequest(); });
+	}
+
+	void CleanUp()
+	{
+		{
+			std::lock_guard<std::mutex> lock(requestMutex);
+
+			for (auto& [coordinate, request] : requests)
+				request->cancelled = true;
+		}
+
+		// Joins the workers, every submitted task has run by then and each request is in queued or completed.
+		delete pool;
+		pool = nullptr;
+
+		for (auto& [coordinate, request] : requests)
+			request->chunk->CleanUp();
+
+		requests.clear();
+		queued.clear();
+		completed.clear();
+
+		for (int i = 1; i < CHUNK_STAGE_COUNT; i++)
+		{
+			const ChunkStage stage = static_cast<ChunkStage>(i);
+
+			Logger_WriteConsole(fmt::format("Chunk stage '{}': {:.3f} ms on average over {} runs", ChunkStages::GetName(stage), stageTimer.GetAverageMilliseconds(stage), stageTimer.GetCount(stage)), LogLevel::DEBUG);
+		}
+
+		for (auto& [coordinate, chunk] : chunks)
+		{
+			SaveChunk(coordinate, chunk);
+			chunk->CleanUp();
+		}
+
+		chunks.clear();
+		edits.clear();
+
+		for (auto& [coordinate, region] : regions)
+		{
+			if (region)
+				region->Close();
+
+			delete region;
+		}
+
+		regions.clear();
+
+		delete terrainProgram;
+		terrainProgram = nullptr;
+	}
 }
 
+std::unordered_map<glm::ivec3, Chunk*, ChunkCoordinateHash> World::chunks;
+std::unordered_map<glm::ivec3, std::shared_ptr<ChunkRequest>, ChunkCoordinateHash> World::requests;
+std::vector<std::shared_ptr<ChunkRequest>> World::queued;
+std::vector<std::shared_ptr<ChunkRequest>> World::completed;
+std::mutex World::requestMutex;
+ThreadPool* World::pool = nullptr;
+ChunkStageTimer World::stageTimer;
+NoiseProgram* World::terrainProgram = nullptr;
+std::unordered_map<glm::ivec3, RegionFile*, ChunkCoordinateHash> World::regions;
+std::unordered_map<glm::ivec3, EditLayer, ChunkCoordinateHash> World::edits;
+
 #endif // !WORLD_HPP
\ No newline at end of file
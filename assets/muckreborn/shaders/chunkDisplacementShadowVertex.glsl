@@ -0,0 +1,56 @@
+#version 330 core
+
+uniform mat4 lightSpaceMatrix;
+uniform mat4 model;
+
+// Same morph as chunkDisplacementVertex.glsl, so the shadow caster is the surface that's drawn.
+uniform vec3 viewPos;
+uniform vec2 morphRange;
+
+uniform int gridCells;
+uniform float gridStep;
+uniform float skirtDepth;
+uniform float heightQuantum;
+uniform usampler2D heightmap;
+
+float GetHeight(int x, int z)
+{
+    return (float(texelFetch(heightmap, ivec2(x + 1, z + 1), 0).r) - 32768.0) * heightQuantum;
+}
+
+float GetMorphHeight(int x, int z)
+{
+    if (z % 2 == 0)
+        return x % 2 == 0 ? GetHeight(x, z) : (GetHeight(x - 1, z) + GetHeight(x + 1, z)) * 0.5;
+
+    if (x % 2 == 0)
+        return (GetHeight(x, z - 1) + GetHeight(x, z + 1)) * 0.5;
+
+    return (GetHeight(x + 1, z - 1) + GetHeight(x - 1, z + 1)) * 0.5;
+}
+
+void main()
+{
+    int side = gridCells + 1;
+    int skirt = gl_VertexID - side * side;
+    int offset = skirt % gridCells;
+    ivec2 cell = ivec2(gl_VertexID % side, gl_VertexID / side);
+
+    if (skirt >= 0)
+    {
+        switch (skirt / gridCells)
+        {
+        case 0: cell = ivec2(offset, 0); break;
+        case 1: cell = ivec2(gridCells, offset); break;
+        case 2: cell = ivec2(gridCells - offset, gridCells); break;
+        default: cell = ivec2(0, gridCells - offset); break;
+        }
+    }
+
+    vec2 grid = vec2(cell) * gridStep;
+    vec3 worldPos = vec3(model * vec4(grid.x, 0.0, grid.y, 1.0));
+    float morph = clamp((distance(worldPos.xz, viewPos.xz) - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);
+    float height = mix(GetHeight(cell.x, cell.y), GetMorphHeight(cell.x, cell.y), morph) - (skirt >= 0 ? skirtDepth : 0.0);
+
+    gl_Position = lightSpaceMatrix * model * vec4(grid.x, height, grid.y, 1.0);
+}
\ No newline at end of file
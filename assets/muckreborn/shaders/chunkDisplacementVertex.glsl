@@ -0,0 +1,84 @@
+#version 330 core
+
+out vec3 ourColor;
+out vec2 TexCoord;
+out vec3 FragPos;
+out vec4 FragPosLightSpace;
+out vec3 normal;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform mat4 lightSpaceMatrix;
+
+uniform vec3 viewPos;
+uniform vec2 morphRange;
+
+// The chunk is gridCells cells per side of gridStep units, followed by a skirt of gridCells * 4 vertices hanging
+// skirtDepth below the border, in the vertex order of TerrainMesher.
+uniform int gridCells;
+uniform float gridStep;
+uniform float skirtDepth;
+uniform float heightQuantum;
+
+// RG16UI with one texel of apron: r is the height in heightQuantum steps biased by 32768, g the color as RGB565
+// over TERRAIN_VERTEX_COLOR_RANGE.
+uniform usampler2D heightmap;
+
+float GetHeight(int x, int z)
+{
+    return (float(texelFetch(heightmap, ivec2(x + 1, z + 1), 0).r) - 32768.0) * heightQuantum;
+}
+
+// Height on the grid of half the cells, the same rule as TerrainMesher::GetMorphHeight.
+float GetMorphHeight(int x, int z)
+{
+    if (z % 2 == 0)
+        return x % 2 == 0 ? GetHeight(x, z) : (GetHeight(x - 1, z) + GetHeight(x + 1, z)) * 0.5;
+
+    if (x % 2 == 0)
+        return (GetHeight(x, z - 1) + GetHeight(x, z + 1)) * 0.5;
+
+    return (GetHeight(x + 1, z - 1) + GetHeight(x - 1, z + 1)) * 0.5;
+}
+
+ivec2 GetGridPosition(int id)
+{
+    int side = gridCells + 1;
+
+    if (id < side * side)
+        return ivec2(id % side, id / side);
+
+    int skirt = id - side * side;
+    int offset = skirt % gridCells;
+
+    switch (skirt / gridCells)
+    {
+    case 0: return ivec2(offset, 0);
+    case 1: return ivec2(gridCells, offset);
+    case 2: return ivec2(gridCells - offset, gridCells);
+    default: return ivec2(0, gridCells - offset);
+    }
+}
+
+void main()
+{
+    ivec2 cell = GetGridPosition(gl_VertexID);
+    float drop = gl_VertexID >= (gridCells + 1) * (gridCells + 1) ? skirtDepth : 0.0;
+    vec2 grid = vec2(cell) * gridStep;
+
+    vec3 worldPos = vec3(model * vec4(grid.x, 0.0, grid.y, 1.0));
+    float morph = clamp((distance(worldPos.xz, viewPos.xz) - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);
+    vec3 position = vec3(grid.x, mix(GetHeight(cell.x, cell.y), GetMorphHeight(cell.x, cell.y), morph) - drop, grid.y);
+
+    float dx = GetHeight(cell.x + 1, cell.y) - GetHeight(cell.x - 1, cell.y);
+    float dz = GetHeight(cell.x, cell.y + 1) - GetHeight(cell.x, cell.y - 1);
+    uint color = texelFetch(heightmap, cell + 1, 0).g;
+
+    FragPos = vec3(model * vec4(position, 1.0));
+    gl_Position = projection * view * vec4(FragPos, 1.0f);
+    ourColor = vec3(float(color >> 11u) / 31.0, float((color >> 5u) & 63u) / 63.0, float(color & 31u) / 31.0) * 2.0;
+    TexCoord = grid;
+    normal = normalize(vec3(-dx, 2.0 * gridStep, -dz));
+    FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
+}
\ No newline at end of file
@@ -111,7 +111,7 @@ void main()
     litColor4 = pow(litColor4, vec3(1.0/2.2));
 
     vec3 gradientResult = mix(litColor1, litColor2, factor1) + mix(litColor3, litColor4, factor2);
-    FragColor = vec4(gradientResult, 1.0);
+    FragColor = vec4(gradientResult * ourColor, 1.0);
 }
 
 float ShadowCalculation(vec4 fragPosLightSpace)
@@ -0,0 +1,22 @@
+#version 330 core
+layout (location = 0) in vec2 aHeight;
+layout (location = 3) in vec2 aGrid;
+
+uniform mat4 lightSpaceMatrix;
+uniform mat4 model;
+
+// Same morph as chunkVertex.glsl, so the shadow caster is the surface that's drawn.
+uniform vec3 viewPos;
+uniform vec2 morphRange;
+
+uniform float gridStep;
+uniform float heightQuantum;
+
+void main()
+{
+    vec2 grid = aGrid * gridStep;
+    vec3 worldPos = vec3(model * vec4(grid.x, 0.0, grid.y, 1.0));
+    float morph = clamp((distance(worldPos.xz, viewPos.xz) - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);
+
+    gl_Position = lightSpaceMatrix * model * vec4(grid.x, mix(aHeight.x, aHeight.y, morph) * heightQuantum, grid.y, 1.0);
+}
\ No newline at end of file
@@ -1,8 +1,8 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aColor;
-layout (location = 2) in vec3 aNormal;
-layout (location = 3) in vec2 aTexCoord;
+layout (location = 0) in vec2 aHeight;
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in vec2 aNormal;
+layout (location = 3) in vec2 aGrid;
 
 out vec3 ourColor;
 out vec2 TexCoord;
@@ -15,12 +15,37 @@ uniform mat4 view;
 uniform mat4 projection;
 uniform mat4 lightSpaceMatrix;
 
+uniform vec3 viewPos;
+
+// Horizontal distances over which vertices slide onto the next detail level, aHeight.y holds their height there.
+uniform vec2 morphRange;
+
+// TerrainVertex decoding: aGrid counts gridStep units, aHeight counts heightQuantum units and aColor is a fraction
+// of TERRAIN_VERTEX_COLOR_RANGE.
+uniform float gridStep;
+uniform float heightQuantum;
+
+vec3 DecodeNormal(vec2 encoded)
+{
+    vec3 decoded = vec3(encoded.x, 1.0 - abs(encoded.x) - abs(encoded.y), encoded.y);
+
+    if (decoded.y < 0.0)
+        decoded.xz = (1.0 - abs(encoded.yx)) * vec2(encoded.x >= 0.0 ? 1.0 : -1.0, encoded.y >= 0.0 ? 1.0 : -1.0);
+
+    return normalize(decoded);
+}
+
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    gl_Position = projection * view * model * vec4(aPos, 1.0f);
-    ourColor = aColor;
-    TexCoord = aTexCoord;
-    normal = aNormal;
+    vec2 grid = aGrid * gridStep;
+    vec3 worldPos = vec3(model * vec4(grid.x, 0.0, grid.y, 1.0));
+    float morph = clamp((distance(worldPos.xz, viewPos.xz) - morphRange.x) / (morphRange.y - morphRange.x), 0.0, 1.0);
+    vec3 position = vec3(grid.x, mix(aHeight.x, aHeight.y, morph) * heightQuantum, grid.y);
+
+    FragPos = vec3(model * vec4(position, 1.0));
+    gl_Position = projection * view * vec4(FragPos, 1.0f);
+    ourColor = aColor.rgb * 2.0;
+    TexCoord = grid;
+    normal = DecodeNormal(aNormal / 127.0);
     FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
 }
\ No newline at end of file